@@ -10,6 +10,7 @@
 #include "fw/components/Transform.hpp"
 #include "fw/models/StaticModel.hpp"
 #include "fw/models/RenderMesh.hpp"
+#include "fw/models/SurfaceLodMesh.hpp"
 #include "fw/Resources.hpp"
 
 #include "fw/rendering/Light.hpp"
@@ -131,6 +132,48 @@ void ForwardRenderingSystem::update(
         }
     }
 
+    entityx::ComponentHandle<fw::SurfaceLodMesh> surfaceLodMesh;
+    for (auto entity: entities.entities_with_components(
+            transformation,
+            surfaceLodMesh
+        ))
+    {
+        auto lodChain = surfaceLodMesh->getLodChain();
+        auto material = entity.component<fw::Material>();
+        if (!lodChain || !material)
+        {
+            continue;
+        }
+
+        auto modelMatrix = transformation->getTransform();
+        auto level = lodChain->selectLevel(
+            projectionMatrix * viewMatrix * modelMatrix,
+            framebufferSize
+        );
+
+        // until selected level is built in background, closest one is drawn
+        auto mesh = lodChain->getMesh(level);
+        if (!mesh)
+        {
+            continue;
+        }
+
+        _universalPhongEffect->setLight(currentLightTransform, currentLight);
+        _universalPhongEffect->setMaterial(*material);
+        _universalPhongEffect->setIrradianceMap(_irradianceMap);
+        _universalPhongEffect->setPrefilterMap(_prefilterMap);
+        _universalPhongEffect->setBrdfLut(_brdfLut);
+
+        _universalPhongEffect->begin();
+        _universalPhongEffect->setProjectionMatrix(projectionMatrix);
+        _universalPhongEffect->setViewMatrix(viewMatrix);
+        _universalPhongEffect->setModelMatrix(modelMatrix);
+
+        mesh->render();
+
+        _universalPhongEffect->end();
+    }
+
     for (auto entity:
             entities.entities_with_components(transformation, light))
     {
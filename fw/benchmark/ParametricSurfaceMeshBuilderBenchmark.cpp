@@ -0,0 +1,54 @@
+#include "fw/common/ThreadPool.hpp"
+#include "fw/numerical/CommonBsplineSurfaces.hpp"
+#include "fw/numerical/ParametricSurfaceMeshBuilder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+int main()
+{
+    const glm::ivec2 resolution{1024, 1024};
+    const int repetitions = 3;
+
+    auto surface = fw::createBsplinePlane(
+        {0.0, 0.0, 0.0},
+        {1.0, 0.0, 0.0},
+        {0.0, 0.0, 1.0},
+        {1.0, 1.0, 1.0}
+    );
+
+    fw::ParametricSurfaceMeshBuilder builder;
+    builder.setSamplingResolution(resolution);
+
+    std::vector<fw::VertexNormalTexCoords> vertices;
+    std::vector<GLuint> indices;
+
+    auto maxThreads = std::max(1, fw::ThreadPool::getDefaultNumThreads());
+    std::cout << "threads\tvertices/s" << std::endl;
+
+    for (auto numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        builder.setThreadPool(numThreads > 1
+            ? std::make_shared<fw::ThreadPool>(numThreads)
+            : nullptr
+        );
+
+        auto start = std::chrono::high_resolution_clock::now();
+        for (auto i = 0; i < repetitions; ++i)
+        {
+            builder.buildGeometry(*surface, vertices, indices);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+
+        std::chrono::duration<double> elapsed = end - start;
+        auto verticesPerSecond =
+            repetitions * vertices.size() / elapsed.count();
+
+        std::cout << numThreads << "\t" << verticesPerSecond << std::endl;
+    }
+
+    return 0;
+}
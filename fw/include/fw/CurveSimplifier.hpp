@@ -1,5 +1,9 @@
 #pragma once
 #include "glm/glm.hpp"
+#include "fw/common/ThreadPool.hpp"
+#include <algorithm>
+#include <memory>
+#include <utility>
 #include <vector>
 
 namespace fw
@@ -14,15 +18,61 @@ public:
     TPrecision getMinimumMergeCosine() const;
     void setMinimumMergeCosine(TPrecision minimum);
 
+    TPrecision getMaximumDeviation() const;
+    void setMaximumDeviation(TPrecision maximum);
+
+    // Curves with more points than twice the chunk size are split into
+    // chunks simplified concurrently, when thread pool is set.
+    int getParallelChunkSize() const;
+    void setParallelChunkSize(int chunkSize);
+
+    void setThreadPool(std::shared_ptr<ThreadPool> threadPool);
+    std::shared_ptr<ThreadPool> getThreadPool() const;
+
+    // Merges nearly collinear neighbours, distance from the input is not
+    // bounded.
     std::vector<TVector> simplify(const std::vector<TVector>& curve) const;
 
+    // Douglas-Peucker simplification, every input point lies within
+    // maximum deviation from the result, which keeps both curve ends.
+    std::vector<TVector> simplifyWithinDeviation(
+        const std::vector<TVector>& curve
+    ) const;
+
 private:
+    TPrecision getSquaredDistanceToSegment(
+        const TVector& point,
+        const TVector& segmentStart,
+        const TVector& segmentEnd
+    ) const;
+
+    bool isWithinDeviation(
+        const std::vector<TVector>& curve,
+        int first,
+        int last,
+        int &farthest
+    ) const;
+
+    // Marks points of (first, last) kept by Douglas-Peucker, ends are
+    // expected to be marked by the caller.
+    void markKeptPoints(
+        const std::vector<TVector>& curve,
+        int first,
+        int last,
+        std::vector<char>& kept
+    ) const;
+
     TPrecision _minimumMergeCosine;
+    TPrecision _maximumDeviation;
+    int _parallelChunkSize;
+    std::shared_ptr<ThreadPool> _threadPool;
 };
 
 template <typename TVector, typename TPrecision>
 CurveSimplifier<TVector, TPrecision>::CurveSimplifier():
-    _minimumMergeCosine{static_cast<TPrecision>(0.9999)}
+    _minimumMergeCosine{static_cast<TPrecision>(0.9999)},
+    _maximumDeviation{static_cast<TPrecision>(10e-4)},
+    _parallelChunkSize{16384}
 {
 }
 
@@ -40,6 +90,49 @@ void CurveSimplifier<TVector, TPrecision>::setMinimumMergeCosine(
     _minimumMergeCosine = minimum;
 }
 
+template <typename TVector, typename TPrecision>
+TPrecision CurveSimplifier<TVector, TPrecision>::getMaximumDeviation() const
+{
+    return _maximumDeviation;
+}
+
+template <typename TVector, typename TPrecision>
+void CurveSimplifier<TVector, TPrecision>::setMaximumDeviation(
+    TPrecision maximum
+)
+{
+    _maximumDeviation = maximum;
+}
+
+template <typename TVector, typename TPrecision>
+int CurveSimplifier<TVector, TPrecision>::getParallelChunkSize() const
+{
+    return _parallelChunkSize;
+}
+
+template <typename TVector, typename TPrecision>
+void CurveSimplifier<TVector, TPrecision>::setParallelChunkSize(
+    int chunkSize
+)
+{
+    _parallelChunkSize = std::max(2, chunkSize);
+}
+
+template <typename TVector, typename TPrecision>
+void CurveSimplifier<TVector, TPrecision>::setThreadPool(
+    std::shared_ptr<ThreadPool> threadPool
+)
+{
+    _threadPool = threadPool;
+}
+
+template <typename TVector, typename TPrecision>
+std::shared_ptr<ThreadPool>
+        CurveSimplifier<TVector, TPrecision>::getThreadPool() const
+{
+    return _threadPool;
+}
+
 template <typename TVector, typename TPrecision>
 std::vector<TVector> CurveSimplifier<TVector, TPrecision>::simplify(
     const std::vector<TVector>& curve
@@ -77,4 +170,165 @@ std::vector<TVector> CurveSimplifier<TVector, TPrecision>::simplify(
     return simplifiedCurve;
 }
 
+template <typename TVector, typename TPrecision>
+std::vector<TVector>
+        CurveSimplifier<TVector, TPrecision>::simplifyWithinDeviation(
+    const std::vector<TVector>& curve
+) const
+{
+    if (curve.size() <= 2) { return curve; }
+
+    auto numPoints = static_cast<int>(curve.size());
+    std::vector<char> kept(numPoints, 0);
+
+    auto isParallel = _threadPool != nullptr
+        && _threadPool->getNumThreads() > 1
+        && numPoints > 2 * _parallelChunkSize;
+
+    if (!isParallel)
+    {
+        kept.front() = kept.back() = 1;
+        markKeptPoints(curve, 0, numPoints - 1, kept);
+    }
+    else
+    {
+        // chunks share boundary points, which are marked up front so that
+        // every chunk writes only to its interior
+        auto numChunks = (numPoints - 1 + _parallelChunkSize - 1)
+            / _parallelChunkSize;
+        auto getBoundary = [&](int chunk) {
+            return static_cast<int>(
+                static_cast<long long>(numPoints - 1) * chunk / numChunks
+            );
+        };
+
+        for (auto chunk = 0; chunk <= numChunks; ++chunk)
+        {
+            kept[getBoundary(chunk)] = 1;
+        }
+
+        _threadPool->parallelFor(0, numChunks, [&](int begin, int end) {
+            for (auto chunk = begin; chunk < end; ++chunk)
+            {
+                markKeptPoints(
+                    curve,
+                    getBoundary(chunk),
+                    getBoundary(chunk + 1),
+                    kept
+                );
+            }
+        });
+
+        // boundary point is dropped when span between its kept neighbours
+        // stays within deviation, so chunking leaves no extra vertices
+        auto previous = 0;
+        for (auto chunk = 1; chunk < numChunks; ++chunk)
+        {
+            auto boundary = getBoundary(chunk);
+            auto next = boundary + 1;
+            while (!kept[next]) { ++next; }
+
+            auto farthest = 0;
+            if (isWithinDeviation(curve, previous, next, farthest))
+            {
+                kept[boundary] = 0;
+            }
+
+            previous = boundary;
+            while (!kept[previous]) { --previous; }
+        }
+    }
+
+    std::vector<TVector> simplifiedCurve;
+    for (auto i = 0; i < numPoints; ++i)
+    {
+        if (kept[i])
+        {
+            simplifiedCurve.push_back(curve[i]);
+        }
+    }
+
+    return simplifiedCurve;
+}
+
+template <typename TVector, typename TPrecision>
+TPrecision CurveSimplifier<TVector, TPrecision>::getSquaredDistanceToSegment(
+    const TVector& point,
+    const TVector& segmentStart,
+    const TVector& segmentEnd
+) const
+{
+    auto direction = segmentEnd - segmentStart;
+    auto squaredLength = glm::dot(direction, direction);
+    auto offset = point - segmentStart;
+    if (squaredLength <= static_cast<TPrecision>(0))
+    {
+        return glm::dot(offset, offset);
+    }
+
+    auto t = glm::clamp(
+        glm::dot(offset, direction) / squaredLength,
+        static_cast<TPrecision>(0),
+        static_cast<TPrecision>(1)
+    );
+
+    auto difference = offset - t * direction;
+    return glm::dot(difference, difference);
+}
+
+template <typename TVector, typename TPrecision>
+bool CurveSimplifier<TVector, TPrecision>::isWithinDeviation(
+    const std::vector<TVector>& curve,
+    int first,
+    int last,
+    int &farthest
+) const
+{
+    auto maximumSquaredDistance = static_cast<TPrecision>(-1);
+    for (auto i = first + 1; i < last; ++i)
+    {
+        auto squaredDistance = getSquaredDistanceToSegment(
+            curve[i],
+            curve[first],
+            curve[last]
+        );
+
+        if (squaredDistance > maximumSquaredDistance)
+        {
+            maximumSquaredDistance = squaredDistance;
+            farthest = i;
+        }
+    }
+
+    return maximumSquaredDistance <= _maximumDeviation * _maximumDeviation;
+}
+
+template <typename TVector, typename TPrecision>
+void CurveSimplifier<TVector, TPrecision>::markKeptPoints(
+    const std::vector<TVector>& curve,
+    int first,
+    int last,
+    std::vector<char>& kept
+) const
+{
+    // explicit stack of spans instead of recursion, deep recursion on
+    // long curves would overflow the stack
+    std::vector<std::pair<int, int>> spans{{first, last}};
+    while (!spans.empty())
+    {
+        auto span = spans.back();
+        spans.pop_back();
+
+        auto farthest = span.first;
+        if (isWithinDeviation(curve, span.first, span.second, farthest))
+        {
+            continue;
+        }
+
+        kept[farthest] = 1;
+        spans.push_back({span.first, farthest});
+        spans.push_back({farthest, span.second});
+    }
+}
+
 }
@@ -26,7 +26,8 @@ public:
     Mesh(
         const std::vector<VertexType> &vertices,
         const std::vector<GLuint> &indices,
-        GLenum primitiveType = GL_TRIANGLES
+        GLenum primitiveType = GL_TRIANGLES,
+        GLenum usage = GL_STATIC_DRAW
     );
 
     Mesh(const Mesh<VertexType> &mesh) = delete;
@@ -37,6 +38,15 @@ public:
     virtual void destroy();
     virtual void render() const;
 
+    // Replaces numVertices vertices starting at firstVertex without
+    // reallocating buffers. Meshes updated often should be created with
+    // GL_DYNAMIC_DRAW usage.
+    void updateVertices(
+        int firstVertex,
+        int numVertices,
+        const VertexType *vertices
+    );
+
 protected:
     GLenum _primitiveType;
     GLuint _vao, _vbo, _ebo;
@@ -44,7 +54,8 @@ protected:
 
     void createBuffers(
         const std::vector<VertexType> &vertices,
-        const std::vector<GLuint> &indices
+        const std::vector<GLuint> &indices,
+        GLenum usage
     );
 
     void destroyBuffers();
@@ -64,7 +75,8 @@ template <typename VertexType>
 Mesh<VertexType>::Mesh(
     const std::vector<VertexType> &vertices,
     const std::vector<GLuint> &indices,
-    GLenum primitiveType
+    GLenum primitiveType,
+    GLenum usage
 ):
     _numElements{0},
     _vao{0},
@@ -72,7 +84,7 @@ Mesh<VertexType>::Mesh(
     _ebo{0},
     _primitiveType{primitiveType}
 {
-    createBuffers(vertices, indices);
+    createBuffers(vertices, indices, usage);
 }
 
 template <typename VertexType>
@@ -106,10 +118,26 @@ void Mesh<VertexType>::render() const
     glBindVertexArray(0);
 }
 
+template <typename VertexType>
+void Mesh<VertexType>::updateVertices(
+    int firstVertex,
+    int numVertices,
+    const VertexType *vertices
+)
+{
+    if (numVertices <= 0) { return; }
+
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferSubData(GL_ARRAY_BUFFER, firstVertex * sizeof(VertexType),
+        numVertices * sizeof(VertexType), vertices);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
 template <typename VertexType>
 void Mesh<VertexType>::createBuffers(
     const std::vector<VertexType> &vertices,
-    const std::vector<GLuint> &indices
+    const std::vector<GLuint> &indices,
+    GLenum usage
 )
 {
     glGenVertexArrays(1, &_vao);
@@ -124,7 +152,7 @@ void Mesh<VertexType>::createBuffers(
 
     glBindBuffer(GL_ARRAY_BUFFER, _vbo);
     glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(VertexType),
-        vertices.data(), GL_STATIC_DRAW);
+        vertices.data(), usage);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
     glBufferData(GL_ELEMENT_ARRAY_BUFFER,
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace fw
+{
+
+class ThreadPool
+{
+public:
+    explicit ThreadPool(int numThreads = getDefaultNumThreads());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    static int getDefaultNumThreads();
+    int getNumThreads() const;
+
+    std::future<void> enqueue(std::function<void()> task);
+
+    // Splits [begin, end) into contiguous ranges processed concurrently and
+    // blocks until all of them are done. Must not be called from a task
+    // running on the same pool.
+    void parallelFor(
+        int begin,
+        int end,
+        const std::function<void(int rangeBegin, int rangeEnd)> &body
+    );
+
+private:
+    void processTasks();
+
+    bool _stopping;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    std::queue<std::function<void()>> _tasks;
+    std::vector<std::thread> _workers;
+};
+
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "fw/numerical/ParametricSurfaceLodChain.hpp"
+
+#include <memory>
+
+namespace fw
+{
+
+// Renders tessellated parametric surface at level of detail chosen every
+// frame from its projected size.
+class SurfaceLodMesh
+{
+public:
+    SurfaceLodMesh();
+    SurfaceLodMesh(std::shared_ptr<ParametricSurfaceLodChain> lodChain);
+    virtual ~SurfaceLodMesh();
+
+    const std::shared_ptr<ParametricSurfaceLodChain> getLodChain() const
+    {
+        return _lodChain;
+    }
+
+    void setLodChain(std::shared_ptr<ParametricSurfaceLodChain> lodChain)
+    {
+        _lodChain = lodChain;
+    }
+
+private:
+    std::shared_ptr<ParametricSurfaceLodChain> _lodChain;
+};
+
+}
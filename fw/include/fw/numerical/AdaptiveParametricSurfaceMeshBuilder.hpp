@@ -0,0 +1,63 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "IParametricSurfaceUV.hpp"
+#include "Mesh.hpp"
+#include "Vertices.hpp"
+
+namespace fw
+{
+
+// Controls subdivision of parameter cells. Cell is split while distance of
+// surface from its bilinear approximation (chord height, in scene units)
+// exceeds tolerance. With screen space error the distance is projected
+// from eye position, projection scale is viewport height in pixels over
+// 2 tan(fovy / 2) and tolerance is given in pixels.
+struct AdaptiveTessellationSettings
+{
+public:
+    AdaptiveTessellationSettings();
+
+    glm::ivec2 initialResolution;
+    int maximumDepth;
+    double chordHeightTolerance;
+    bool useScreenSpaceError;
+    glm::dvec3 eyePosition;
+    double projectionScale;
+    double screenSpaceTolerance;
+};
+
+// Builds meshes from restricted quadtree over parameter domain. Neighbour
+// cells differ by at most one subdivision level, cells next to finer ones
+// are triangulated as fans through edge midpoints, so there are no cracks
+// between levels.
+class AdaptiveParametricSurfaceMeshBuilder
+{
+public:
+    AdaptiveParametricSurfaceMeshBuilder();
+    ~AdaptiveParametricSurfaceMeshBuilder();
+
+    const AdaptiveTessellationSettings &getSettings() const;
+    void setSettings(const AdaptiveTessellationSettings &settings);
+
+    std::shared_ptr<Mesh<VertexNormalTexCoords>> build(
+        std::shared_ptr<IParametricSurfaceUV> surface,
+        glm::dvec2 minimumParameter = glm::dvec2(0.0, 0.0),
+        glm::dvec2 maximumParmeter = glm::dvec2(1.0, 1.0)
+    ) const;
+
+    void buildGeometry(
+        const IParametricSurfaceUV &surface,
+        std::vector<VertexNormalTexCoords> &vertices,
+        std::vector<GLuint> &indices,
+        glm::dvec2 minimumParameter = glm::dvec2(0.0, 0.0),
+        glm::dvec2 maximumParmeter = glm::dvec2(1.0, 1.0)
+    ) const;
+
+private:
+    AdaptiveTessellationSettings _settings;
+};
+
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "fw/AABB.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace fw
+{
+
+// Bezier segment covering single knot span of a curve (or single edge of
+// a polyline). Like BezierSurfacePatch, it lies inside convex hull of its
+// own control points, so it may be bounded and subdivided independently.
+struct BezierCurveSegment
+{
+public:
+    static constexpr int MaxDegree = 15;
+
+    BezierCurveSegment();
+    ~BezierCurveSegment();
+
+    // Bounds of control points, segment lies inside by convex hull property.
+    AABB<glm::dvec3> getBounds() const;
+
+    // Parameter is given in parameters of the source curve.
+    glm::dvec3 getPosition(double parameter) const;
+    glm::dvec3 getDerivative(double parameter) const;
+
+    // Splits segment at given parameter with de Casteljau algorithm, both
+    // parts keep parameters of the source curve.
+    void split(
+        double parameter,
+        BezierCurveSegment &lower,
+        BezierCurveSegment &upper
+    ) const;
+
+    int degree;
+    double minimumParameter;
+    double maximumParameter;
+    std::vector<glm::dvec3> controlPoints;
+};
+
+// Linear segments between consecutive points, i-th point is reached at
+// parameter i.
+std::vector<BezierCurveSegment> createPolylineSegments(
+    const std::vector<glm::dvec3> &points
+);
+
+}
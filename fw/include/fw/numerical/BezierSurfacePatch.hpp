@@ -0,0 +1,46 @@
+#pragma once
+
+#include "fw/AABB.hpp"
+#include "IParametricSurfaceUV.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace fw
+{
+
+// Tensor product Bezier patch covering single knot span rectangle of
+// a B-spline surface. Control points tightly bound the patch, unlike
+// control points of B-spline spans which are shared with neighbours.
+struct BezierSurfacePatch
+{
+public:
+    static constexpr int MaxDegree = 15;
+
+    BezierSurfacePatch();
+    ~BezierSurfacePatch();
+
+    // Bounds of control points, patch lies inside by convex hull property.
+    AABB<glm::dvec3> getBounds() const;
+
+    // Parametrisation is given in parameters of the source surface.
+    glm::dvec3 getPosition(glm::dvec2 parametrisation) const;
+
+    // Splits patch at given parameter of one axis, every row (axis U) or
+    // column (axis V) of control points is split as a Bezier curve.
+    void split(
+        ParametrizationAxis axis,
+        double parameter,
+        BezierSurfacePatch &lower,
+        BezierSurfacePatch &upper
+    ) const;
+
+    int degree;
+    glm::dvec2 minimumParameter;
+    glm::dvec2 maximumParameter;
+    // (degree + 1) x (degree + 1) points stored row by row (V major)
+    std::vector<glm::dvec3> controlPoints;
+};
+
+}
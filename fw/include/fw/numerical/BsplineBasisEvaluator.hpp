@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IBasisEvaluator.hpp"
+#include <memory>
 #include <vector>
 
 namespace fw
@@ -10,20 +11,83 @@ class BsplineBasisEvaluator:
     public IBasisEvaluator
 {
 public:
+    // Upper bound of degree supported by evaluateNonVanishingDerivatives,
+    // callers may use it to size their stack buffers.
+    static constexpr int MaxLocalDegree = 15;
+
+    // Knots with reciprocals of knot differences 1 / (t(i+d) - t(i)) for
+    // every d up to maxDegree, zero where interval vanishes. Immutable and
+    // shared between copies of evaluator and evaluators of lower degree.
+    struct KnotTables
+    {
+    public:
+        KnotTables(int maxDegree, const std::vector<double> &knots);
+
+        double getReciprocal(int degree, int knot) const
+        {
+            return reciprocals[degree * knots.size() + knot];
+        }
+
+        const int maxDegree;
+        const std::vector<double> knots;
+        std::vector<double> reciprocals;
+    };
+
     BsplineBasisEvaluator(
         int degree,
         const std::vector<double> &knots
     );
 
+    // Reuses tables built for the same knots and at least given degree.
+    BsplineBasisEvaluator(
+        int degree,
+        std::shared_ptr<const KnotTables> knotTables
+    );
+
     virtual ~BsplineBasisEvaluator(); 
 
     virtual std::vector<double> evaluate(
         double parameter
     ) const override;
 
+    virtual int getSupportSize() const override;
+
+    // Evaluates only degree+1 basis functions N(span-degree) ... N(span),
+    // output buffer must be able to hold getSupportSize() values.
+    // Returns -1 (and zero basis) when parameter is outside of knot vector.
+    virtual int evaluateNonVanishing(
+        double parameter,
+        double *output
+    ) const override;
+
+    // Evaluates derivatives up to given order of degree+1 non-vanishing
+    // basis functions. Output is laid out as (order+1) rows of degree+1
+    // values, row k containing k-th derivatives. Returns span as above.
+    int evaluateNonVanishingDerivatives(
+        double parameter,
+        int order,
+        double *output
+    ) const;
+
+    // Evaluates non-vanishing basis functions of every degree d from 0 up
+    // to evaluator degree. Output is laid out as degree+1 rows of degree+1
+    // values, row d holding N(span-degree+k, d) at k (zero for k < degree-d).
+    // Returns span as above.
+    int evaluateNonVanishingAllDegrees(
+        double parameter,
+        double *output
+    ) const;
+
+    int findKnotSpan(double parameter) const;
+
+    int getDegree() const;
+    const std::vector<double> &getKnots() const;
+    std::shared_ptr<const KnotTables> getKnotTables() const;
+
 protected:
     const int _degree;
-    const std::vector<double> _knots;
+    std::shared_ptr<const KnotTables> _knotTables;
+    const std::vector<double> &_knots;
 
     std::vector<double> evaluateZeroDegreeBasis(
         double parameter
@@ -34,6 +98,19 @@ protected:
         int currentDegreeOfBasis,
         double paramter
     ) const;
+
+    void increaseLocalBasisDegree(
+        double *basis,
+        int span,
+        int targetDegree,
+        double parameter
+    ) const;
+
+    void differentiateLocalBasis(
+        double *basis,
+        int span,
+        int targetDegree
+    ) const;
 };
 
 }
@@ -22,11 +22,24 @@ public:
         std::vector<TFloating> knots,
         int derivativeOrder = 0
     );
+
+    // Shares knots and knot tables of given evaluator, which may be built
+    // for higher degree (as for derivative curves).
+    BsplineCurve(
+        int degree,
+        std::vector<TPoint> controlPoints,
+        const BsplineBasisEvaluator &knotsEvaluator,
+        int derivativeOrder = 0
+    );
+
     virtual ~BsplineCurve() = default;
 
     int getDegree() const { return _degree; }
     int getDerivativeOrder() const { return _derivativeOrder; }
     virtual const std::vector<TPoint> &getControlPoints() const;
+
+    // Knots are kept only in knot tables shared with basis evaluator (and
+    // derivative curves).
     virtual const std::vector<TFloating> &getKnots() const;
 
     virtual TPoint evaluate(TFloating parameter) const override;
@@ -39,10 +52,14 @@ public:
     ) const;
 
 private:
+    void initialize(
+        const std::vector<TPoint> &controlPoints,
+        std::shared_ptr<const BsplineBasisEvaluator::KnotTables> knotTables
+    );
+
     int _degree;
     int _derivativeOrder;
     std::vector<TPoint> _controlPoints;
-    std::vector<TFloating> _knots;
     std::shared_ptr<BsplineBasisEvaluator> _basisEvaluator;
     std::shared_ptr<LinearCombinationEvaluator<TPoint, TFloating>>
         _linearCombination;
@@ -62,10 +79,37 @@ BsplineCurve<TPoint, TFloating>::BsplineCurve(
     int derivativeOrder
 ):
     _degree{degree},
-    _derivativeOrder{derivativeOrder},
-    _controlPoints(_derivativeOrder + controlPoints.size()),
-    _knots{knots}
+    _derivativeOrder{derivativeOrder}
+{
+    initialize(
+        controlPoints,
+        std::make_shared<const BsplineBasisEvaluator::KnotTables>(
+            _degree,
+            knots
+        )
+    );
+}
+
+template<typename TPoint, typename TFloating>
+BsplineCurve<TPoint, TFloating>::BsplineCurve(
+    int degree,
+    std::vector<TPoint> controlPoints,
+    const BsplineBasisEvaluator &knotsEvaluator,
+    int derivativeOrder
+):
+    _degree{degree},
+    _derivativeOrder{derivativeOrder}
+{
+    initialize(controlPoints, knotsEvaluator.getKnotTables());
+}
+
+template<typename TPoint, typename TFloating>
+void BsplineCurve<TPoint, TFloating>::initialize(
+    const std::vector<TPoint> &controlPoints,
+    std::shared_ptr<const BsplineBasisEvaluator::KnotTables> knotTables
+)
 {
+    _controlPoints.resize(_derivativeOrder + controlPoints.size());
     for (auto i = 0; i < controlPoints.size(); ++i)
     {
         _controlPoints[_derivativeOrder + i] = controlPoints[i];
@@ -73,7 +117,7 @@ BsplineCurve<TPoint, TFloating>::BsplineCurve(
 
     _basisEvaluator = std::make_shared<BsplineBasisEvaluator>(
         _degree,
-        _knots
+        knotTables
     );
 
     _linearCombination =
@@ -100,7 +144,7 @@ template<typename TPoint, typename TFloating>
 const std::vector<TFloating> &BsplineCurve<TPoint, TFloating>::getKnots(
 ) const
 {
-    return _knots;
+    return _basisEvaluator->getKnots();
 }
 
 template<typename TPoint, typename TFloating>
@@ -119,10 +163,11 @@ std::shared_ptr<BsplineCurve<TPoint, TFloating>>
 {
     if (_derivativeCurve == nullptr)
     {
+        const auto &knots = getKnots();
         std::vector<TPoint> derivativeControlPoints(_controlPoints.size() - 1);
         for (auto i = 0; i < _controlPoints.size() - 1; ++i)
         {
-            auto coefficient = (_degree) / (_knots[i+_degree+1] - _knots[i+1]);
+            auto coefficient = (_degree) / (knots[i+_degree+1] - knots[i+1]);
             auto newControlPoint =
                 coefficient * (_controlPoints[i+1] - _controlPoints[i]);
 
@@ -132,7 +177,7 @@ std::shared_ptr<BsplineCurve<TPoint, TFloating>>
         _derivativeCurve = std::make_shared<BsplineCurve<TPoint, TFloating>>(
             _degree - 1,
             derivativeControlPoints,
-            _knots,
+            *_basisEvaluator,
             _derivativeOrder + 1
         );
     }
@@ -0,0 +1,316 @@
+#pragma once
+
+#include "BezierCurveSegment.hpp"
+#include "BezierSurfacePatch.hpp"
+#include "BsplineCurve.hpp"
+#include "BsplineSurface.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace fw
+{
+
+// Knot refinement utilities. Curves and surfaces of degree p with n control
+// points are expected to have n + p + 1 knots, knots inserted must lie in
+// the non-vanishing domain [knots[p], knots[n]]. Refined surfaces are
+// returned unfolded, their control grid is the folded grid of the source.
+
+template<typename TFloating>
+int getKnotMultiplicity(const std::vector<TFloating> &knots, TFloating knot);
+
+// Boehm knot insertion (The NURBS Book A5.1 for single insertion). Control
+// polygon is refined for knot vector before insertion, knots are left as
+// they are so many polygons over the same knots can be refined. Returns
+// false when knot already has multiplicity of degree and nothing changes.
+template<typename TPoint, typename TFloating>
+bool insertKnotIntoControlPolygon(
+    int degree,
+    const std::vector<TFloating> &knots,
+    TFloating knot,
+    std::vector<TPoint> &controlPoints
+);
+
+// Inserts knot into both control polygon and knot vector.
+template<typename TPoint, typename TFloating>
+bool insertKnot(
+    int degree,
+    TFloating knot,
+    std::vector<TFloating> &knots,
+    std::vector<TPoint> &controlPoints
+);
+
+template<typename TPoint, typename TFloating>
+std::shared_ptr<BsplineCurve<TPoint, TFloating>> insertKnot(
+    const BsplineCurve<TPoint, TFloating> &curve,
+    TFloating knot,
+    int times = 1
+);
+
+// Control polygons of Bezier segments of the curve, ordered by parameter.
+template<typename TPoint, typename TFloating>
+std::vector<std::vector<TPoint>> decomposeIntoBezierSegments(
+    const BsplineCurve<TPoint, TFloating> &curve
+);
+
+// Clamped curve equal to given one over [begin, end].
+template<typename TPoint, typename TFloating>
+std::shared_ptr<BsplineCurve<TPoint, TFloating>> extractSegment(
+    const BsplineCurve<TPoint, TFloating> &curve,
+    TFloating begin,
+    TFloating end
+);
+
+// Bezier segments of the curve with their parameter ranges, ordered by
+// parameter.
+std::vector<BezierCurveSegment> decomposeIntoBezierCurveSegments(
+    const BsplineCurve3d &curve
+);
+
+std::shared_ptr<BsplineSurface> insertKnot(
+    const BsplineSurface &surface,
+    ParametrizationAxis axis,
+    double knot,
+    int times = 1
+);
+
+// Bezier patches of all non-empty knot span rectangles of the surface,
+// ordered row by row (V major).
+std::vector<BezierSurfacePatch> decomposeIntoBezierPatches(
+    const BsplineSurface &surface
+);
+
+// Clamped surface equal to given one over parameter rectangle.
+std::shared_ptr<BsplineSurface> extractPatch(
+    const BsplineSurface &surface,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter
+);
+
+namespace internal
+{
+
+// Inserts knot until it reaches given multiplicity.
+template<typename TPoint, typename TFloating>
+void refineKnot(
+    int degree,
+    TFloating knot,
+    int multiplicity,
+    std::vector<TFloating> &knots,
+    std::vector<TPoint> &controlPoints
+)
+{
+    while (getKnotMultiplicity(knots, knot) < multiplicity
+        && insertKnot(degree, knot, knots, controlPoints))
+    {
+    }
+}
+
+// Last span starting at begin and last span ending at end, these are
+// bounds of control points of spline over [begin, end] with both knots
+// of multiplicity at least degree.
+template<typename TFloating>
+glm::ivec2 getSegmentSpans(
+    const std::vector<TFloating> &knots,
+    TFloating begin,
+    TFloating end
+)
+{
+    auto first = static_cast<int>(std::distance(
+        std::begin(knots),
+        std::upper_bound(std::begin(knots), std::end(knots), begin)
+    )) - 1;
+
+    auto last = static_cast<int>(std::distance(
+        std::begin(knots),
+        std::lower_bound(std::begin(knots), std::end(knots), end)
+    )) - 1;
+
+    return {first, last};
+}
+
+}
+
+template<typename TFloating>
+int getKnotMultiplicity(const std::vector<TFloating> &knots, TFloating knot)
+{
+    auto range = std::equal_range(std::begin(knots), std::end(knots), knot);
+    return static_cast<int>(std::distance(range.first, range.second));
+}
+
+template<typename TPoint, typename TFloating>
+bool insertKnotIntoControlPolygon(
+    int degree,
+    const std::vector<TFloating> &knots,
+    TFloating knot,
+    std::vector<TPoint> &controlPoints
+)
+{
+    auto numPoints = static_cast<int>(controlPoints.size());
+    assert(static_cast<int>(knots.size()) == numPoints + degree + 1);
+    assert(knots[degree] <= knot && knot <= knots[numPoints]);
+
+    auto multiplicity = getKnotMultiplicity(knots, knot);
+    if (multiplicity >= degree)
+    {
+        return false;
+    }
+
+    auto span = static_cast<int>(std::distance(
+        std::begin(knots),
+        std::upper_bound(std::begin(knots), std::end(knots), knot)
+    )) - 1;
+
+    // points up to span - degree stay, points after span - multiplicity
+    // shift by one and the ones between are blended
+    std::vector<TPoint> refined(numPoints + 1);
+    for (auto i = 0; i <= span - degree; ++i)
+    {
+        refined[i] = controlPoints[i];
+    }
+
+    for (auto i = span - multiplicity + 1; i <= numPoints; ++i)
+    {
+        refined[i] = controlPoints[i - 1];
+    }
+
+    for (auto i = span - degree + 1; i <= span - multiplicity; ++i)
+    {
+        auto alpha = (knot - knots[i]) / (knots[i + degree] - knots[i]);
+        refined[i] = alpha * controlPoints[i]
+            + (TFloating(1) - alpha) * controlPoints[i - 1];
+    }
+
+    controlPoints.swap(refined);
+    return true;
+}
+
+template<typename TPoint, typename TFloating>
+bool insertKnot(
+    int degree,
+    TFloating knot,
+    std::vector<TFloating> &knots,
+    std::vector<TPoint> &controlPoints
+)
+{
+    if (!insertKnotIntoControlPolygon(degree, knots, knot, controlPoints))
+    {
+        return false;
+    }
+
+    knots.insert(
+        std::upper_bound(std::begin(knots), std::end(knots), knot),
+        knot
+    );
+
+    return true;
+}
+
+template<typename TPoint, typename TFloating>
+std::shared_ptr<BsplineCurve<TPoint, TFloating>> insertKnot(
+    const BsplineCurve<TPoint, TFloating> &curve,
+    TFloating knot,
+    int times
+)
+{
+    auto knots = curve.getKnots();
+    auto controlPoints = curve.getControlPoints();
+
+    for (auto i = 0; i < times; ++i)
+    {
+        insertKnot(curve.getDegree(), knot, knots, controlPoints);
+    }
+
+    return std::make_shared<BsplineCurve<TPoint, TFloating>>(
+        curve.getDegree(),
+        controlPoints,
+        knots
+    );
+}
+
+template<typename TPoint, typename TFloating>
+std::vector<std::vector<TPoint>> decomposeIntoBezierSegments(
+    const BsplineCurve<TPoint, TFloating> &curve
+)
+{
+    auto degree = curve.getDegree();
+    auto knots = curve.getKnots();
+    auto controlPoints = curve.getControlPoints();
+
+    std::vector<TFloating> domainKnots(
+        std::begin(knots) + degree,
+        std::begin(knots) + controlPoints.size() + 1
+    );
+
+    domainKnots.erase(
+        std::unique(std::begin(domainKnots), std::end(domainKnots)),
+        std::end(domainKnots)
+    );
+
+    for (auto knot: domainKnots)
+    {
+        internal::refineKnot(degree, knot, degree, knots, controlPoints);
+    }
+
+    // every span has now Bezier points as its degree + 1 control points
+    auto numPoints = static_cast<int>(controlPoints.size());
+    std::vector<std::vector<TPoint>> segments;
+    for (auto span = degree; span < numPoints; ++span)
+    {
+        if (knots[span] < knots[span + 1])
+        {
+            segments.emplace_back(
+                std::begin(controlPoints) + span - degree,
+                std::begin(controlPoints) + span + 1
+            );
+        }
+    }
+
+    return segments;
+}
+
+template<typename TPoint, typename TFloating>
+std::shared_ptr<BsplineCurve<TPoint, TFloating>> extractSegment(
+    const BsplineCurve<TPoint, TFloating> &curve,
+    TFloating begin,
+    TFloating end
+)
+{
+    assert(begin < end);
+
+    auto degree = curve.getDegree();
+    auto knots = curve.getKnots();
+    auto controlPoints = curve.getControlPoints();
+
+    internal::refineKnot(degree, begin, degree, knots, controlPoints);
+    internal::refineKnot(degree, end, degree, knots, controlPoints);
+
+    auto spans = internal::getSegmentSpans(knots, begin, end);
+
+    std::vector<TPoint> segmentPoints(
+        std::begin(controlPoints) + spans.x - degree,
+        std::begin(controlPoints) + spans.y + 1
+    );
+
+    // outermost knots do not affect the segment, they only clamp it
+    std::vector<TFloating> segmentKnots(
+        std::begin(knots) + spans.x - degree,
+        std::begin(knots) + spans.y + degree + 2
+    );
+
+    segmentKnots.front() = begin;
+    segmentKnots.back() = end;
+
+    return std::make_shared<BsplineCurve<TPoint, TFloating>>(
+        degree,
+        segmentPoints,
+        segmentKnots
+    );
+}
+
+}
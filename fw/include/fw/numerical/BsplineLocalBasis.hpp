@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace fw
+{
+
+constexpr int DynamicBsplineDegree = -1;
+
+// Evaluates degree+1 non-vanishing basis functions N(span-degree) ...
+// N(span) with their first derivatives in given precision. When degree is
+// given as template argument all loops have compile-time bounds and are
+// unrolled by compiler, DynamicBsplineDegree takes degree at runtime.
+// Only spans with complete support (span >= degree and span + degree
+// within knot vector) are handled, others report -1 so callers may fall
+// back to BsplineBasisEvaluator.
+template <typename TFloating, int Degree = DynamicBsplineDegree>
+class BsplineLocalBasis
+{
+public:
+    static constexpr int MaxDegree = 15;
+
+    explicit BsplineLocalBasis(int degree = Degree);
+
+    int getDegree() const;
+
+    int evaluate(
+        const std::vector<TFloating> &knots,
+        TFloating parameter,
+        TFloating *basis,
+        TFloating *derivatives
+    ) const;
+
+private:
+    int _degree;
+};
+
+template <typename TFloating, int Degree>
+BsplineLocalBasis<TFloating, Degree>::BsplineLocalBasis(int degree):
+    _degree{degree}
+{
+}
+
+template <typename TFloating, int Degree>
+int BsplineLocalBasis<TFloating, Degree>::getDegree() const
+{
+    return Degree != DynamicBsplineDegree ? Degree : _degree;
+}
+
+template <typename TFloating, int Degree>
+int BsplineLocalBasis<TFloating, Degree>::evaluate(
+    const std::vector<TFloating> &knots,
+    TFloating parameter,
+    TFloating *basis,
+    TFloating *derivatives
+) const
+{
+    const auto degree = getDegree();
+    const auto numKnots = static_cast<int>(knots.size());
+
+    if (numKnots < 2
+        || parameter < knots.front()
+        || !(parameter < knots.back()))
+    {
+        return -1;
+    }
+
+    auto span = static_cast<int>(std::distance(
+        std::begin(knots),
+        std::upper_bound(std::begin(knots), std::end(knots), parameter)
+    )) - 1;
+
+    if (span < degree || span + degree >= numKnots)
+    {
+        return -1;
+    }
+
+    // triangular scheme from The NURBS Book (A2.2), denominators never
+    // vanish as every one of them spans the non-empty knot span
+    TFloating left[MaxDegree + 1], right[MaxDegree + 1];
+    TFloating lowerBasis[MaxDegree + 1];
+
+    basis[0] = TFloating(1);
+    for (auto j = 1; j <= degree; ++j)
+    {
+        left[j] = parameter - knots[span + 1 - j];
+        right[j] = knots[span + j] - parameter;
+
+        if (j == degree)
+        {
+            for (auto r = 0; r < degree; ++r)
+            {
+                lowerBasis[r] = basis[r];
+            }
+        }
+
+        TFloating saved = TFloating(0);
+        for (auto r = 0; r < j; ++r)
+        {
+            auto temp = basis[r] / (right[r + 1] + left[j - r]);
+            basis[r] = saved + right[r + 1] * temp;
+            saved = left[j - r] * temp;
+        }
+
+        basis[j] = saved;
+    }
+
+    if (derivatives == nullptr)
+    {
+        return span;
+    }
+
+    if (degree == 0)
+    {
+        derivatives[0] = TFloating(0);
+        return span;
+    }
+
+    // N'(i, p) = p * (N(i, p-1) / (t(i+p) - t(i))
+    //     - N(i+1, p-1) / (t(i+p+1) - t(i+1))), lowerBasis[k] = N(i+1, p-1)
+    for (auto k = 0; k <= degree; ++k)
+    {
+        auto i = span - degree + k;
+        auto derivative = TFloating(0);
+
+        if (k > 0)
+        {
+            derivative += lowerBasis[k - 1] / (knots[i + degree] - knots[i]);
+        }
+
+        if (k < degree)
+        {
+            derivative -=
+                lowerBasis[k] / (knots[i + degree + 1] - knots[i + 1]);
+        }
+
+        derivatives[k] = degree * derivative;
+    }
+
+    return span;
+}
+
+}
@@ -3,6 +3,7 @@
 #include "BsplineSurface.hpp"
 
 #include <memory>
+#include <vector>
 
 namespace fw
 {
@@ -31,11 +32,44 @@ public:
         glm::dvec2 parametrisation
     ) const override;
 
+    virtual bool isPeriodic(ParametrizationAxis axis) const override;
+
+    virtual SurfaceEvaluation evaluate(
+        glm::dvec2 parametrisation,
+        int order
+    ) const override;
+
+    virtual void sampleGridRows(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        glm::dvec3 *positions,
+        glm::dvec3 *normals
+    ) const override;
+
+    virtual void sampleGridRowsSinglePrecision(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        glm::vec3 *positions,
+        glm::vec3 *normals
+    ) const override;
+
+    // Support of control point of underlying surface expressed in this
+    // parametrisation and clipped to unit square.
+    std::vector<AABB<glm::dvec2>> getControlPointSupport(int u, int v) const;
+
 private:
-    glm::dvec2 calculateReparametrizationDerivativeFactors() const;
     glm::dvec2 calculateReparametrization(glm::dvec2 parametrization) const;
 
     std::shared_ptr<BsplineSurface> _bsplineSurface;
+    // unit square maps onto [origin, origin + scale] of underlying surface
+    glm::dvec2 _parameterOrigin;
+    glm::dvec2 _parameterScale;
 };
 
 }
@@ -1,7 +1,10 @@
 #pragma once
 
+#include "fw/AABB.hpp"
 #include "IParametricSurfaceUV.hpp"
+#include "BsplineBasisEvaluator.hpp"
 #include "BsplineCurve.hpp"
+#include "BsplineSurfaceSampler.hpp"
 
 #include <glm/glm.hpp>
 
@@ -46,22 +49,95 @@ public:
         glm::dvec2 parametrisation
     ) const override;
 
+    virtual SurfaceEvaluation evaluate(
+        glm::dvec2 parametrisation,
+        int order
+    ) const override;
+
+    virtual void sampleGridRows(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        glm::dvec3 *positions,
+        glm::dvec3 *normals
+    ) const override;
+
+    virtual void sampleGridRowsSinglePrecision(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        glm::vec3 *positions,
+        glm::vec3 *normals
+    ) const override;
+
     virtual std::shared_ptr<ICurve3d> getConstParameterCurve(
         ParametrizationAxis constParameter,
         double parameter
     ) const override;
 
+    virtual bool isPeriodic(ParametrizationAxis axis) const override;
+
     int getDegree() const;
+    SurfaceFoldingMode getFoldingMode() const;
     const std::vector<glm::dvec3> &getControlPoints() const;
     const std::vector<double> &getKnotsOnU() const;
     const std::vector<double> &getKnotsOnV() const;
 
+    // Control grid extended by fold depth on continuous axis, knot spans
+    // index this grid directly.
+    glm::ivec2 getFoldedGridSize() const;
+    const glm::dvec3 &getFoldedControlPoint(int u, int v) const;
+
+    // Moves control point (u, v) of the unfolded grid. Only surface over
+    // regions returned by getControlPointSupport changes.
+    void setControlPoint(int u, int v, const glm::dvec3 &point);
+
+    // Parameter regions over which surface depends on control point (u, v),
+    // one region for every copy of the point in folded grid.
+    std::vector<AABB<glm::dvec2>> getControlPointSupport(int u, int v) const;
+
 protected:
+    static constexpr int MaxDerivativeOrder = 2;
+
     std::vector<glm::dvec3> evaluateConstParamControlPoints(
         int rowOrColumn,
         ParametrizationAxis constDirection
     ) const;
 
+    // Control net of partial derivative of the surface (hodograph) on
+    // folded grid, point (u, v) is stored at v * size.x + u. Net of k-th
+    // derivative on an axis is longer by k, as boundary terms are kept.
+    struct DerivativeNet
+    {
+    public:
+        glm::ivec2 size;
+        std::vector<glm::dvec3> points;
+    };
+
+    void createDerivativeNets();
+    void createSinglePrecisionSampler();
+    DerivativeNet differentiateNet(
+        const DerivativeNet &net,
+        ParametrizationAxis axis,
+        int netDerivativeOrder
+    ) const;
+
+    // Sums derivative nets weighted by non-vanishing basis functions of
+    // lowered degrees (laid out as in BsplineBasisEvaluator all degrees
+    // evaluation) given for spans on both parametrisation axes.
+    void evaluateTensorProduct(
+        int order,
+        int spanU,
+        const double *basisU,
+        int spanV,
+        const double *basisV,
+        SurfaceEvaluation &evaluation
+    ) const;
+
 private:
     int _degree;
     int _foldDepth;
@@ -70,6 +146,13 @@ private:
     std::vector<double> _knotsU;
     std::vector<double> _knotsV;
     SurfaceFoldingMode _foldingMode;
+    BsplineBasisEvaluator _basisEvaluatorU;
+    BsplineBasisEvaluator _basisEvaluatorV;
+    // [k][l] holds net of derivative of order k on U and l on V
+    DerivativeNet
+        _derivativeNets[MaxDerivativeOrder + 1][MaxDerivativeOrder + 1];
+    // display tessellation is sampled in single precision
+    std::shared_ptr<const BsplineSurfaceSampler3f> _singlePrecisionSampler;
 };
 
 }
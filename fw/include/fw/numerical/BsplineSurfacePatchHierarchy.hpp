@@ -0,0 +1,91 @@
+#pragma once
+
+#include "fw/AABB.hpp"
+#include "BsplineSurface.hpp"
+#include "ParametricSurfaceIntersection.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace fw
+{
+
+// Single non-vanishing knot span of a surface. By convex hull property
+// surface over the span lies inside bounds of its (degree+1)x(degree+1)
+// control points.
+struct BsplineSurfacePatch
+{
+public:
+    glm::ivec2 span;
+    glm::dvec2 minimumParameter;
+    glm::dvec2 maximumParameter;
+    AABB<glm::dvec3> bounds;
+};
+
+struct BsplineSurfacePatchPair
+{
+public:
+    int lhsPatch;
+    int rhsPatch;
+    AABB<glm::dvec3> overlap;
+};
+
+// Bounding volume hierarchy over surface patches. Used for quick rejection
+// of non-intersecting surfaces and for finding intersection seed regions.
+class BsplineSurfacePatchHierarchy
+{
+public:
+    BsplineSurfacePatchHierarchy(
+        const BsplineSurface& surface,
+        int maximumLeafPatches = 2
+    );
+    ~BsplineSurfacePatchHierarchy();
+
+    bool isEmpty() const;
+    AABB<glm::dvec3> getBounds() const;
+    const std::vector<BsplineSurfacePatch> &getPatches() const;
+
+    // Dual tree traversal, each overlapping patch pair is reported once.
+    std::vector<BsplineSurfacePatchPair> findOverlappingPatches(
+        const BsplineSurfacePatchHierarchy& other
+    ) const;
+
+    // Overlap regions of patch pairs, regions touching each other are
+    // merged so every region roughly covers one intersection branch.
+    std::vector<AABB<glm::dvec3>> findIntersectionSeedRegions(
+        const BsplineSurfacePatchHierarchy& other
+    ) const;
+
+    // Seed for every overlapping patch pair, indexed by regions returned
+    // from findIntersectionSeedRegions and ordered by them. Parameters are
+    // centres of patch parameter ranges expressed in unit square of
+    // non-vanishing domain, like in BsplineNonVanishingReparametrization.
+    std::vector<IntersectionSeed> findIntersectionSeeds(
+        const BsplineSurfacePatchHierarchy& other
+    ) const;
+
+protected:
+    struct Node
+    {
+    public:
+        AABB<glm::dvec3> bounds;
+        int firstChild;
+        int firstPatch;
+        int numPatches;
+    };
+
+    void createPatches(const BsplineSurface& surface);
+    glm::dvec2 getUnitParameters(const BsplineSurfacePatch& patch) const;
+    void buildNode(int nodeIndex, int firstPatch, int numPatches);
+
+private:
+    int _maximumLeafPatches;
+    // unit square maps onto [origin, origin + scale] of the surface domain
+    glm::dvec2 _parameterOrigin;
+    glm::dvec2 _parameterScale;
+    std::vector<BsplineSurfacePatch> _patches;
+    std::vector<Node> _nodes;
+};
+
+}
@@ -0,0 +1,343 @@
+#pragma once
+
+#include "BsplineBasisEvaluator.hpp"
+#include "BsplineLocalBasis.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <vector>
+
+namespace fw
+{
+
+// Samples B-spline surface grids in chosen precision. Control net is kept
+// as separate coordinate arrays, so collapsing rows of the net vectorizes,
+// and bicubic surfaces use basis evaluation with compile-time degree.
+// Used for display tessellation in single precision, while evaluation for
+// interrogation stays in double precision in BsplineSurface.
+template<typename TPoint, typename TFloating>
+class BsplineSurfaceSampler
+{
+public:
+    // Control points are given on folded grid, row by row (V major).
+    BsplineSurfaceSampler(
+        int degree,
+        glm::ivec2 gridSize,
+        const std::vector<glm::dvec3> &controlPoints,
+        const std::vector<double> &knotsU,
+        const std::vector<double> &knotsV
+    );
+
+    ~BsplineSurfaceSampler() = default;
+
+    // Same grid and output layout as IParametricSurfaceUV::sampleGridRows.
+    void sampleGridRows(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        TPoint *positions,
+        TPoint *normals
+    ) const;
+
+protected:
+    template<int Degree>
+    void sampleGridRowsWithDegree(
+        const BsplineLocalBasis<TFloating, Degree> &localBasis,
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        TPoint *positions,
+        TPoint *normals
+    ) const;
+
+    template<int Degree>
+    int evaluateBasis(
+        const BsplineLocalBasis<TFloating, Degree> &localBasis,
+        const std::vector<TFloating> &knots,
+        const BsplineBasisEvaluator &fallbackEvaluator,
+        double parameter,
+        TFloating *basis,
+        TFloating *derivatives
+    ) const;
+
+    static double getGridSampleParameter(
+        double minimumParameter,
+        double maximumParameter,
+        int sample,
+        int resolution
+    );
+
+private:
+    int _degree;
+    glm::ivec2 _gridSize;
+    std::vector<TFloating> _coordinates[3];
+    std::vector<TFloating> _knotsU;
+    std::vector<TFloating> _knotsV;
+    BsplineBasisEvaluator _basisEvaluatorU;
+    BsplineBasisEvaluator _basisEvaluatorV;
+};
+
+using BsplineSurfaceSampler3f = BsplineSurfaceSampler<glm::vec3, float>;
+using BsplineSurfaceSampler3d = BsplineSurfaceSampler<glm::dvec3, double>;
+
+template<typename TPoint, typename TFloating>
+BsplineSurfaceSampler<TPoint, TFloating>::BsplineSurfaceSampler(
+    int degree,
+    glm::ivec2 gridSize,
+    const std::vector<glm::dvec3> &controlPoints,
+    const std::vector<double> &knotsU,
+    const std::vector<double> &knotsV
+):
+    _degree{degree},
+    _gridSize{gridSize},
+    _knotsU(std::begin(knotsU), std::end(knotsU)),
+    _knotsV(std::begin(knotsV), std::end(knotsV)),
+    _basisEvaluatorU{degree, knotsU},
+    _basisEvaluatorV{degree, knotsV}
+{
+    auto numControlPoints = static_cast<int>(controlPoints.size());
+    for (auto axis = 0; axis < 3; ++axis)
+    {
+        _coordinates[axis].resize(numControlPoints);
+        for (auto i = 0; i < numControlPoints; ++i)
+        {
+            _coordinates[axis][i] =
+                static_cast<TFloating>(controlPoints[i][axis]);
+        }
+    }
+}
+
+template<typename TPoint, typename TFloating>
+void BsplineSurfaceSampler<TPoint, TFloating>::sampleGridRows(
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter,
+    glm::ivec2 resolution,
+    int firstRow,
+    int numRows,
+    TPoint *positions,
+    TPoint *normals
+) const
+{
+    if (_degree == 3)
+    {
+        sampleGridRowsWithDegree(
+            BsplineLocalBasis<TFloating, 3>{},
+            minimumParameter,
+            maximumParameter,
+            resolution,
+            firstRow,
+            numRows,
+            positions,
+            normals
+        );
+    }
+    else
+    {
+        sampleGridRowsWithDegree(
+            BsplineLocalBasis<TFloating>{_degree},
+            minimumParameter,
+            maximumParameter,
+            resolution,
+            firstRow,
+            numRows,
+            positions,
+            normals
+        );
+    }
+}
+
+template<typename TPoint, typename TFloating>
+template<int Degree>
+void BsplineSurfaceSampler<TPoint, TFloating>::sampleGridRowsWithDegree(
+    const BsplineLocalBasis<TFloating, Degree> &localBasis,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter,
+    glm::ivec2 resolution,
+    int firstRow,
+    int numRows,
+    TPoint *positions,
+    TPoint *normals
+) const
+{
+    const auto degree = localBasis.getDegree();
+    const auto supportSize = degree + 1;
+    const auto withNormals = normals != nullptr;
+
+    // basis values and derivatives, stored one after another per sample
+    std::vector<int> spansU(resolution.x), spansV(numRows);
+    std::vector<TFloating> basisU(2 * resolution.x * supportSize);
+    std::vector<TFloating> basisV(2 * numRows * supportSize);
+
+    for (auto x = 0; x < resolution.x; ++x)
+    {
+        auto basis = basisU.data() + 2 * x * supportSize;
+        spansU[x] = evaluateBasis(
+            localBasis,
+            _knotsU,
+            _basisEvaluatorU,
+            getGridSampleParameter(
+                minimumParameter.x,
+                maximumParameter.x,
+                x,
+                resolution.x
+            ),
+            basis,
+            basis + supportSize
+        );
+    }
+
+    for (auto y = 0; y < numRows; ++y)
+    {
+        auto basis = basisV.data() + 2 * y * supportSize;
+        spansV[y] = evaluateBasis(
+            localBasis,
+            _knotsV,
+            _basisEvaluatorV,
+            getGridSampleParameter(
+                minimumParameter.y,
+                maximumParameter.y,
+                firstRow + y,
+                resolution.y
+            ),
+            basis,
+            basis + supportSize
+        );
+    }
+
+    // net collapsed on V for current row, value and derivative for every
+    // coordinate, each kept in a contiguous array
+    std::vector<TFloating> collapsed(6 * _gridSize.x);
+
+    for (auto y = 0; y < numRows; ++y)
+    {
+        std::fill(std::begin(collapsed), std::end(collapsed), TFloating(0));
+
+        auto spanV = spansV[y];
+        auto rowBasis = basisV.data() + 2 * y * supportSize;
+        auto firstV = spanV - degree;
+
+        for (auto j = std::max(0, -firstV); spanV >= 0 && j <= degree; ++j)
+        {
+            auto v = firstV + j;
+            if (v >= _gridSize.y) { break; }
+
+            for (auto axis = 0; axis < 3; ++axis)
+            {
+                const auto source = _coordinates[axis].data() + v * _gridSize.x;
+                auto value = collapsed.data() + axis * _gridSize.x;
+                auto derivative = collapsed.data() + (3 + axis) * _gridSize.x;
+                auto weight = rowBasis[j];
+                auto derivativeWeight = rowBasis[supportSize + j];
+
+                for (auto u = 0; u < _gridSize.x; ++u)
+                {
+                    value[u] += weight * source[u];
+                }
+
+                for (auto u = 0; withNormals && u < _gridSize.x; ++u)
+                {
+                    derivative[u] += derivativeWeight * source[u];
+                }
+            }
+        }
+
+        for (auto x = 0; x < resolution.x; ++x)
+        {
+            auto spanU = spansU[x];
+            auto columnBasis = basisU.data() + 2 * x * supportSize;
+            auto firstU = spanU - degree;
+
+            TFloating position[3] = {}, derivativeU[3] = {};
+            TFloating derivativeV[3] = {};
+
+            for (auto i = std::max(0, -firstU);
+                spanU >= 0 && spanV >= 0 && i <= degree; ++i)
+            {
+                auto u = firstU + i;
+                if (u >= _gridSize.x) { break; }
+
+                for (auto axis = 0; axis < 3; ++axis)
+                {
+                    auto value = collapsed[axis * _gridSize.x + u];
+                    position[axis] += columnBasis[i] * value;
+                    derivativeU[axis] += columnBasis[supportSize + i] * value;
+                    derivativeV[axis] += columnBasis[i]
+                        * collapsed[(3 + axis) * _gridSize.x + u];
+                }
+            }
+
+            auto sampleIndex = y * resolution.x + x;
+            positions[sampleIndex] = {position[0], position[1], position[2]};
+
+            if (withNormals)
+            {
+                normals[sampleIndex] = glm::normalize(glm::cross(
+                    TPoint{derivativeV[0], derivativeV[1], derivativeV[2]},
+                    TPoint{derivativeU[0], derivativeU[1], derivativeU[2]}
+                ));
+            }
+        }
+    }
+}
+
+template<typename TPoint, typename TFloating>
+template<int Degree>
+int BsplineSurfaceSampler<TPoint, TFloating>::evaluateBasis(
+    const BsplineLocalBasis<TFloating, Degree> &localBasis,
+    const std::vector<TFloating> &knots,
+    const BsplineBasisEvaluator &fallbackEvaluator,
+    double parameter,
+    TFloating *basis,
+    TFloating *derivatives
+) const
+{
+    auto span = localBasis.evaluate(
+        knots,
+        static_cast<TFloating>(parameter),
+        basis,
+        derivatives
+    );
+
+    if (span >= 0)
+    {
+        return span;
+    }
+
+    // incomplete support near ends of knot vector is rare in tessellation,
+    // general evaluator handles it
+    const auto supportSize = _degree + 1;
+    double fallbackBasis[2 * (BsplineBasisEvaluator::MaxLocalDegree + 1)];
+    span = fallbackEvaluator.evaluateNonVanishingDerivatives(
+        parameter,
+        1,
+        fallbackBasis
+    );
+
+    for (auto k = 0; k < supportSize; ++k)
+    {
+        basis[k] = static_cast<TFloating>(fallbackBasis[k]);
+        derivatives[k] = static_cast<TFloating>(fallbackBasis[supportSize + k]);
+    }
+
+    return span;
+}
+
+template<typename TPoint, typename TFloating>
+double BsplineSurfaceSampler<TPoint, TFloating>::getGridSampleParameter(
+    double minimumParameter,
+    double maximumParameter,
+    int sample,
+    int resolution
+)
+{
+    if (resolution <= 1) { return minimumParameter; }
+    auto t = static_cast<double>(sample) / (resolution - 1);
+    return glm::mix(minimumParameter, maximumParameter, t);
+}
+
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include "BezierCurveSegment.hpp"
+#include "BsplineSurface.hpp"
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+namespace fw
+{
+
+// Controls root finding. Pairs of overlapping convex hulls are subdivided
+// until both hulls are smaller than seed size (in scene units), then
+// Newton iteration is started from their centres. Roots closer than
+// distance tolerance to the other object are accepted, roots with all
+// parameters within parameter tolerance of already found one are merged.
+struct CurveIntersectionSettings
+{
+public:
+    CurveIntersectionSettings();
+
+    double seedSize;
+    int maximumDepth;
+    int newtonIterationLimit;
+    double distanceTolerance;
+    double parameterTolerance;
+};
+
+struct CurveSurfaceIntersection
+{
+public:
+    double curveParameter;
+    glm::dvec2 surfaceParameters;
+    glm::dvec3 scenePosition;
+};
+
+struct CurveCurveIntersection
+{
+public:
+    double lhsParameter;
+    double rhsParameter;
+    glm::dvec3 scenePosition;
+};
+
+// Finds all intersections of curves given as Bezier segments (see
+// decomposeIntoBezierCurveSegments and createPolylineSegments) with B-spline
+// surfaces and with each other. Results are ordered by (lhs) curve
+// parameter, surface parameters are given in knot domain of the surface.
+// Tangential contacts are reported only when Newton iteration reaches them
+// within distance tolerance.
+class CurveIntersectionFinder
+{
+public:
+    CurveIntersectionFinder();
+    ~CurveIntersectionFinder();
+
+    const CurveIntersectionSettings &getSettings() const;
+    void setSettings(const CurveIntersectionSettings &settings);
+
+    // Amount of Newton solves performed by last intersect call.
+    int getNewtonSolvesCount() const;
+
+    std::vector<CurveSurfaceIntersection> intersect(
+        const std::vector<BezierCurveSegment> &curve,
+        const BsplineSurface &surface
+    );
+
+    std::vector<CurveCurveIntersection> intersect(
+        const std::vector<BezierCurveSegment> &lhs,
+        const std::vector<BezierCurveSegment> &rhs
+    );
+
+private:
+    CurveIntersectionSettings _settings;
+    int _newtonSolvesCount;
+};
+
+}
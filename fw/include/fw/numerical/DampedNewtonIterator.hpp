@@ -0,0 +1,329 @@
+#pragma once
+
+#include "NewtonIterator.hpp"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace fw
+{
+
+// Solves square system matrix * solution = rhs by LU decomposition with
+// partial pivoting. Matrix is column major, as glm matrices are. Returns
+// false when matrix is numerically singular.
+template <typename TMatrix, typename TVector>
+bool solveLinearSystem(
+    const TMatrix& matrix,
+    const TVector& rhs,
+    TVector& solution
+)
+{
+    const auto size = static_cast<int>(rhs.length());
+    auto lu = matrix;
+    solution = rhs;
+
+    double scale = 0.0;
+    for (auto column = 0; column < size; ++column)
+    {
+        for (auto row = 0; row < size; ++row)
+        {
+            scale = std::max(scale, std::abs(lu[column][row]));
+        }
+    }
+
+    const auto singularityThreshold =
+        size * std::numeric_limits<double>::epsilon() * scale;
+
+    for (auto pivot = 0; pivot < size; ++pivot)
+    {
+        auto pivotRow = pivot;
+        for (auto row = pivot + 1; row < size; ++row)
+        {
+            if (std::abs(lu[pivot][row]) > std::abs(lu[pivot][pivotRow]))
+            {
+                pivotRow = row;
+            }
+        }
+
+        if (!(std::abs(lu[pivot][pivotRow]) > singularityThreshold))
+        {
+            return false;
+        }
+
+        if (pivotRow != pivot)
+        {
+            for (auto column = 0; column < size; ++column)
+            {
+                std::swap(lu[column][pivot], lu[column][pivotRow]);
+            }
+
+            std::swap(solution[pivot], solution[pivotRow]);
+        }
+
+        // forward substitution is done along with elimination
+        for (auto row = pivot + 1; row < size; ++row)
+        {
+            auto factor = lu[pivot][row] / lu[pivot][pivot];
+            for (auto column = pivot + 1; column < size; ++column)
+            {
+                lu[column][row] -= factor * lu[column][pivot];
+            }
+
+            solution[row] -= factor * solution[pivot];
+        }
+    }
+
+    for (auto row = size - 1; row >= 0; --row)
+    {
+        for (auto column = row + 1; column < size; ++column)
+        {
+            solution[row] -= lu[column][row] * solution[column];
+        }
+
+        solution[row] /= lu[row][row];
+    }
+
+    return true;
+}
+
+// Newton method with backtracking line search on squared residual norm.
+// Steps are solved from jacobian instead of its inverse. Step is halved
+// until residual decreases sufficiently (Armijo condition) and parameters
+// stay valid, iteration fails when step becomes shorter than minimum scale.
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+class DampedNewtonIterator
+{
+public:
+    DampedNewtonIterator();
+    virtual ~DampedNewtonIterator() = default;
+
+    using IMatchingIterable =
+        INewtonIterable<TDomain, TCodomain, TDomainTransformation>;
+
+    int getIterationLimit() const;
+    void setIterationLimit(int iterationLimit);
+
+    // Iteration also succeeds when residual norm drops below tolerance.
+    double getResidualTolerance() const;
+    void setResidualTolerance(double tolerance);
+
+    double getMinimumStepScale() const;
+    void setMinimumStepScale(double minimumStepScale);
+
+    // Fraction of decrease predicted by linearization required to accept
+    // a step.
+    double getSufficientDecrease() const;
+    void setSufficientDecrease(double sufficientDecrease);
+
+    // Steps are stored in result history only when enabled.
+    bool isRecordingHistory() const;
+    void setRecordingHistory(bool recordHistory);
+
+    NewtonIterationResult<TDomain> iterate(
+        IMatchingIterable& iterable,
+        TDomain startParameters
+    ) const;
+
+private:
+    int _iterationLimit;
+    double _residualTolerance;
+    double _minimumStepScale;
+    double _sufficientDecrease;
+    bool _recordHistory;
+};
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        DampedNewtonIterator():
+    _iterationLimit{50},
+    _residualTolerance{1e-12},
+    _minimumStepScale{1.0 / 1024},
+    _sufficientDecrease{1e-4},
+    _recordHistory{false}
+{
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+int DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        getIterationLimit() const
+{
+    return _iterationLimit;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+void DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        setIterationLimit(int iterationLimit)
+{
+    _iterationLimit = iterationLimit;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+double DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        getResidualTolerance() const
+{
+    return _residualTolerance;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+void DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        setResidualTolerance(double tolerance)
+{
+    _residualTolerance = tolerance;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+double DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        getMinimumStepScale() const
+{
+    return _minimumStepScale;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+void DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        setMinimumStepScale(double minimumStepScale)
+{
+    _minimumStepScale = minimumStepScale;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+double DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        getSufficientDecrease() const
+{
+    return _sufficientDecrease;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+void DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        setSufficientDecrease(double sufficientDecrease)
+{
+    _sufficientDecrease = sufficientDecrease;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+bool DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        isRecordingHistory() const
+{
+    return _recordHistory;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+void DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+        setRecordingHistory(bool recordHistory)
+{
+    _recordHistory = recordHistory;
+}
+
+template <typename TDomain, typename TCodomain, typename TDomainTransformation>
+NewtonIterationResult<TDomain>
+        DampedNewtonIterator<TDomain, TCodomain, TDomainTransformation>::
+            iterate(
+    IMatchingIterable& iterable,
+    TDomain startParameters
+) const
+{
+    NewtonIterationResult<TDomain> result{
+        NewtonIterationExitStatus::IterationLimitReached,
+        startParameters
+    };
+
+    iterable.setInitialParameters(startParameters);
+    iterable.setCurrentParameters(startParameters);
+    auto functionValue = iterable.evaluateFunction();
+    result.residualNorm = glm::length(functionValue);
+
+    while (true)
+    {
+        if (result.residualNorm <= _residualTolerance)
+        {
+            result.exitStatus = NewtonIterationExitStatus::Success;
+            break;
+        }
+
+        if (result.iterations >= _iterationLimit)
+        {
+            break;
+        }
+
+        TDomain step;
+        if (!solveLinearSystem(iterable.getJacobian(), functionValue, step))
+        {
+            result.exitStatus = NewtonIterationExitStatus::SingularJacobian;
+            break;
+        }
+
+        auto squaredResidual = result.residualNorm * result.residualNorm;
+        auto stepScale = 1.0;
+        auto accepted = false;
+        auto anyValid = false;
+        auto converged = false;
+        TDomain nextParameters{};
+
+        while (!accepted && stepScale >= _minimumStepScale)
+        {
+            nextParameters = iterable.correctParametrisation(
+                result.parameters - stepScale * step
+            );
+
+            if (iterable.areParametersValid(nextParameters))
+            {
+                anyValid = true;
+
+                // convergence is measured against parameters still set
+                converged = iterable.hasParameterConverged(nextParameters);
+                iterable.setCurrentParameters(nextParameters);
+                auto nextValue = iterable.evaluateFunction();
+                auto nextResidual = glm::length(nextValue);
+
+                // newton direction decreases squared residual at rate of
+                // 2 * squared residual
+                accepted = nextResidual * nextResidual <= squaredResidual
+                    * (1.0 - 2.0 * _sufficientDecrease * stepScale);
+
+                if (accepted)
+                {
+                    functionValue = nextValue;
+                    result.residualNorm = nextResidual;
+                    break;
+                }
+            }
+
+            stepScale *= 0.5;
+        }
+
+        if (!accepted)
+        {
+            // iterable has to describe returned parameters
+            iterable.setCurrentParameters(result.parameters);
+            result.exitStatus = anyValid
+                ? NewtonIterationExitStatus::LineSearchFailed
+                : NewtonIterationExitStatus::InvalidParameterReached;
+            break;
+        }
+
+        if (_recordHistory)
+        {
+            result.history.push_back({
+                glm::length(nextParameters - result.parameters),
+                stepScale,
+                result.residualNorm
+            });
+        }
+
+        result.parameters = nextParameters;
+        ++result.iterations;
+
+        if (converged)
+        {
+            result.exitStatus = NewtonIterationExitStatus::Success;
+            break;
+        }
+    }
+
+    return result;
+}
+
+}
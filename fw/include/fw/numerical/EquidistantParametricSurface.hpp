@@ -10,6 +10,9 @@ namespace fw
 
 class EquidistantParametricSurface;
 
+// Constant parameter curve of offset surface or its derivative of given
+// order. Orders above those evaluated by the surface are computed with
+// central differences of the lower order curve.
 class EquidistantParametricSurfaceCurve:
     public ICurve3d
 {
@@ -17,7 +20,8 @@ public:
     EquidistantParametricSurfaceCurve(
         std::shared_ptr<const EquidistantParametricSurface> referenceSurface,
         ParametrizationAxis constantAxis,
-        double constantParameter
+        double constantParameter,
+        int derivativeOrder = 0
     );
 
     virtual glm::dvec3 evaluate(double parameter) const override;
@@ -26,6 +30,7 @@ public:
 private:
     ParametrizationAxis _constantAxis;
     double _constantParameter;
+    int _derivativeOrder;
     std::shared_ptr<const EquidistantParametricSurface> _referenceSurface;
 };
 
@@ -58,6 +63,29 @@ public:
         glm::dvec2 parametrisation
     ) const override;
 
+    virtual bool isPeriodic(ParametrizationAxis axis) const override;
+
+    // Derivatives of offset follow from second derivatives of reference
+    // surface, so only the first order is available. Higher orders are
+    // clamped and reported by evaluation order, users needing second
+    // derivatives should check it.
+    virtual SurfaceEvaluation evaluate(
+        glm::dvec2 parametrisation,
+        int order
+    ) const override;
+
+    virtual void sampleGridRows(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        glm::dvec3 *positions,
+        glm::dvec3 *normals
+    ) const override;
+
+    static constexpr int MaxDerivativeOrder = 1;
+
 private:
     std::shared_ptr<fw::IParametricSurfaceUV> _referenceSurface;
     double _normalDistance;
@@ -1,6 +1,9 @@
 #pragma once
 #include "glm/glm.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
 #include <vector>
 
 namespace fw
@@ -164,4 +167,561 @@ std::vector<TVector2D> intersectCircles(
     };
 }
 
+// Batch variants of the tests above. Shapes are stored as structure of
+// arrays and processed in fixed size chunks by branchless loops, which
+// compilers turn into SIMD code. Rare cases (parallel segments, circles
+// passing rejection) are finished by scalar functions above, so batches
+// report exactly what pairwise calls would.
+
+template <typename TPrecision>
+struct SegmentBatch
+{
+public:
+    template <typename TVector2D>
+    void add(const TVector2D& start, const TVector2D& end)
+    {
+        auto direction = end - start;
+        startX.push_back(start.x);
+        startY.push_back(start.y);
+        directionX.push_back(direction.x);
+        directionY.push_back(direction.y);
+    }
+
+    void clear()
+    {
+        startX.clear();
+        startY.clear();
+        directionX.clear();
+        directionY.clear();
+    }
+
+    int size() const { return static_cast<int>(startX.size()); }
+
+    std::vector<TPrecision> startX;
+    std::vector<TPrecision> startY;
+    std::vector<TPrecision> directionX;
+    std::vector<TPrecision> directionY;
+};
+
+template <typename TPrecision>
+struct CircleBatch
+{
+public:
+    template <typename TVector2D>
+    void add(const TVector2D& origin, TPrecision radius)
+    {
+        originX.push_back(origin.x);
+        originY.push_back(origin.y);
+        radii.push_back(radius);
+    }
+
+    void clear()
+    {
+        originX.clear();
+        originY.clear();
+        radii.clear();
+    }
+
+    int size() const { return static_cast<int>(originX.size()); }
+
+    std::vector<TPrecision> originX;
+    std::vector<TPrecision> originY;
+    std::vector<TPrecision> radii;
+};
+
+// Result of intersectSegments(lhs, rhs) for pair that intersects, rhs
+// result holds the same intersection in parameters of rhs segment.
+template <typename TPrecision>
+struct SegmentIntersectionHit
+{
+public:
+    int lhsIndex;
+    int rhsIndex;
+    GeometricIntersectionResult<TPrecision> result;
+    GeometricIntersectionResult<TPrecision> rhsResult;
+};
+
+// Result of intersectCircles(lhs, rhs) for pair that intersects.
+template <typename TVector2D>
+struct CircleIntersectionHit
+{
+public:
+    int lhsIndex;
+    int rhsIndex;
+    int numPoints;
+    TVector2D points[2];
+};
+
+namespace internal
+{
+
+constexpr int BatchChunkSize = 64;
+
+enum SegmentLaneState: std::uint8_t
+{
+    SegmentLaneMiss = 0,
+    SegmentLaneHit = 1,
+    SegmentLaneParallel = 2
+};
+
+}
+
+// Tests segment against every segment of the batch, hits are appended
+// with given lhs index and rhs index of batch segment.
+template <typename TVector2D, typename TPrecision>
+void intersectSegmentBatch(
+    const TVector2D& aStart,
+    const TVector2D& aEnd,
+    const SegmentBatch<TPrecision>& batch,
+    std::vector<SegmentIntersectionHit<TPrecision>>& hits,
+    int lhsIndex = 0
+)
+{
+    const TPrecision eps = static_cast<TPrecision>(10e-6);
+    const TPrecision zero = static_cast<TPrecision>(0);
+    const TPrecision one = static_cast<TPrecision>(1);
+    const auto r = aEnd - aStart;
+
+    TPrecision parameters[internal::BatchChunkSize];
+    TPrecision rhsParameters[internal::BatchChunkSize];
+    std::uint8_t states[internal::BatchChunkSize];
+
+    const auto chunkSize = internal::BatchChunkSize;
+    for (auto first = 0; first < batch.size(); first += chunkSize)
+    {
+        auto count = std::min(chunkSize, batch.size() - first);
+        const auto *startX = batch.startX.data() + first;
+        const auto *startY = batch.startY.data() + first;
+        const auto *directionX = batch.directionX.data() + first;
+        const auto *directionY = batch.directionY.data() + first;
+
+        for (auto i = 0; i < count; ++i)
+        {
+            auto qpX = startX[i] - aStart.x;
+            auto qpY = startY[i] - aStart.y;
+            auto rxs = r.x * directionY[i] - r.y * directionX[i];
+            auto qpxr = qpX * r.y - qpY * r.x;
+            auto qpxs = qpX * directionY[i] - qpY * directionX[i];
+
+            // quotients of parallel lanes are garbage and never read
+            auto t = qpxs / rxs;
+            auto u = qpxr / rxs;
+            auto isParallel = std::abs(rxs) <= eps;
+            auto isHit = zero <= t && t <= one && zero <= u && u <= one;
+
+            parameters[i] = t;
+            rhsParameters[i] = u;
+            auto state = isHit
+                ? internal::SegmentLaneHit
+                : internal::SegmentLaneMiss;
+            states[i] = isParallel ? internal::SegmentLaneParallel : state;
+        }
+
+        for (auto i = 0; i < count; ++i)
+        {
+            if (states[i] == internal::SegmentLaneMiss)
+            {
+                continue;
+            }
+
+            GeometricIntersectionResult<TPrecision> result;
+            GeometricIntersectionResult<TPrecision> rhsResult;
+            if (states[i] == internal::SegmentLaneHit)
+            {
+                result.kind = GeometricIntersectionKind::Single;
+                result.t0 = result.t1 = parameters[i];
+                rhsResult.kind = GeometricIntersectionKind::Single;
+                rhsResult.t0 = rhsResult.t1 = rhsParameters[i];
+            }
+            else
+            {
+                TVector2D bStart{startX[i], startY[i]};
+                TVector2D bEnd{
+                    startX[i] + directionX[i],
+                    startY[i] + directionY[i]
+                };
+
+                result = intersectSegments<TVector2D, TPrecision>(
+                    aStart,
+                    aEnd,
+                    bStart,
+                    bEnd
+                );
+
+                if (result.kind == GeometricIntersectionKind::None)
+                {
+                    continue;
+                }
+
+                // overlap is projected back onto rhs segment
+                TVector2D s{directionX[i], directionY[i]};
+                auto ss = glm::dot(s, s);
+                auto scale = ss > zero ? one / ss : zero;
+                auto u0 = glm::dot(aStart + result.t0 * r - bStart, s) * scale;
+                auto u1 = glm::dot(aStart + result.t1 * r - bStart, s) * scale;
+                if (u0 > u1) { std::swap(u0, u1); }
+                rhsResult.kind = result.kind;
+                rhsResult.t0 = std::max(zero, u0);
+                rhsResult.t1 = std::min(one, u1);
+            }
+
+            hits.push_back({lhsIndex, first + i, result, rhsResult});
+        }
+    }
+}
+
+namespace internal
+{
+
+// Bounds of batch segment, group tells which batch segment comes from.
+template <typename TPrecision>
+struct SegmentBounds
+{
+public:
+    TPrecision minX, maxX, minY, maxY;
+    int index;
+    int group;
+};
+
+// Bounds are padded, so touching and collinear segments are kept.
+template <typename TPrecision>
+void appendSegmentBounds(
+    const SegmentBatch<TPrecision>& batch,
+    int group,
+    std::vector<SegmentBounds<TPrecision>>& bounds
+)
+{
+    const TPrecision eps = static_cast<TPrecision>(10e-6);
+    for (auto i = 0; i < batch.size(); ++i)
+    {
+        auto endX = batch.startX[i] + batch.directionX[i];
+        auto endY = batch.startY[i] + batch.directionY[i];
+        bounds.push_back({
+            std::min(batch.startX[i], endX) - eps,
+            std::max(batch.startX[i], endX) + eps,
+            std::min(batch.startY[i], endY) - eps,
+            std::max(batch.startY[i], endY) + eps,
+            i,
+            group
+        });
+    }
+}
+
+// Sweeps along axis of larger extent and returns sorted pairs of segments
+// with overlapping bounds. Segments of group 0 are paired with segments of
+// group 1, or with each other when there is single group, then pairs are
+// given as (lower index, higher index). Takes O(n log n) time plus time
+// proportional to amount of segments with overlapping ranges on the swept
+// axis.
+template <typename TPrecision>
+std::vector<std::pair<int, int>> findOverlappingSegmentBounds(
+    std::vector<SegmentBounds<TPrecision>> bounds,
+    bool isSingleGroup
+)
+{
+    if (bounds.empty())
+    {
+        return {};
+    }
+
+    auto minX = bounds.front().minX;
+    auto maxX = bounds.front().maxX;
+    auto minY = bounds.front().minY;
+    auto maxY = bounds.front().maxY;
+    for (const auto &segment: bounds)
+    {
+        minX = std::min(minX, segment.minX);
+        maxX = std::max(maxX, segment.maxX);
+        minY = std::min(minY, segment.minY);
+        maxY = std::max(maxY, segment.maxY);
+    }
+
+    // polyline running along y would keep every segment in x sweep, so
+    // axes are swapped and sweep goes along y instead
+    if (maxY - minY > maxX - minX)
+    {
+        for (auto &segment: bounds)
+        {
+            std::swap(segment.minX, segment.minY);
+            std::swap(segment.maxX, segment.maxY);
+        }
+    }
+
+    std::sort(
+        std::begin(bounds),
+        std::end(bounds),
+        [](
+            const SegmentBounds<TPrecision> &a,
+            const SegmentBounds<TPrecision> &b
+        )
+        {
+            return a.minX < b.minX;
+        }
+    );
+
+    // every pair is found when the one starting later enters the sweep
+    std::vector<std::pair<int, int>> candidates;
+    std::vector<int> active[2];
+    auto numBounds = static_cast<int>(bounds.size());
+    for (auto i = 0; i < numBounds; ++i)
+    {
+        const auto &current = bounds[i];
+        auto &others = active[isSingleGroup ? 0 : 1 - current.group];
+
+        others.erase(
+            std::remove_if(
+                std::begin(others),
+                std::end(others),
+                [&](int other) { return bounds[other].maxX < current.minX; }
+            ),
+            std::end(others)
+        );
+
+        for (auto other: others)
+        {
+            const auto &otherBounds = bounds[other];
+            if (otherBounds.maxY < current.minY
+                || current.maxY < otherBounds.minY)
+            {
+                continue;
+            }
+
+            auto isCurrentFirst = isSingleGroup
+                ? current.index < otherBounds.index
+                : current.group == 0;
+            candidates.push_back(isCurrentFirst
+                ? std::make_pair(current.index, otherBounds.index)
+                : std::make_pair(otherBounds.index, current.index)
+            );
+        }
+
+        active[isSingleGroup ? 0 : current.group].push_back(i);
+    }
+
+    std::sort(std::begin(candidates), std::end(candidates));
+    return candidates;
+}
+
+// Runs exact tests for sorted candidate pairs, rhs segments of every lhs
+// segment are gathered into single batch. Hits keep order of candidates.
+template <typename TVector2D, typename TPrecision>
+void intersectSegmentCandidates(
+    const SegmentBatch<TPrecision>& lhs,
+    const SegmentBatch<TPrecision>& rhs,
+    const std::vector<std::pair<int, int>>& candidates,
+    std::vector<SegmentIntersectionHit<TPrecision>>& hits
+)
+{
+    auto numCandidates = static_cast<int>(candidates.size());
+    SegmentBatch<TPrecision> gathered;
+    for (auto first = 0; first < numCandidates;)
+    {
+        auto lhsIndex = candidates[first].first;
+        auto last = first;
+        gathered.clear();
+
+        for (; last < numCandidates && candidates[last].first == lhsIndex;
+            ++last)
+        {
+            auto rhsIndex = candidates[last].second;
+            gathered.startX.push_back(rhs.startX[rhsIndex]);
+            gathered.startY.push_back(rhs.startY[rhsIndex]);
+            gathered.directionX.push_back(rhs.directionX[rhsIndex]);
+            gathered.directionY.push_back(rhs.directionY[rhsIndex]);
+        }
+
+        TVector2D aStart{lhs.startX[lhsIndex], lhs.startY[lhsIndex]};
+        TVector2D aDirection{
+            lhs.directionX[lhsIndex],
+            lhs.directionY[lhsIndex]
+        };
+
+        auto numHits = hits.size();
+        intersectSegmentBatch(
+            aStart,
+            aStart + aDirection,
+            gathered,
+            hits,
+            lhsIndex
+        );
+
+        for (auto h = numHits; h < hits.size(); ++h)
+        {
+            hits[h].rhsIndex = candidates[first + hits[h].rhsIndex].second;
+        }
+
+        first = last;
+    }
+}
+
+template <typename TVector2D, typename TPrecision>
+SegmentBatch<TPrecision> createPolylineBatch(
+    const std::vector<TVector2D>& points
+)
+{
+    auto numPoints = static_cast<int>(points.size());
+    SegmentBatch<TPrecision> batch;
+    for (auto i = 0; i + 1 < numPoints; ++i)
+    {
+        batch.add(points[i], points[i + 1]);
+    }
+
+    return batch;
+}
+
+}
+
+// Tests every pair of segments from both batches. Candidate pairs come
+// from sweep along longer axis over segment bounds, so only segments with
+// overlapping bounds are tested exactly. Hits are ordered by lhs index,
+// then by rhs index.
+template <typename TVector2D, typename TPrecision>
+void intersectSegmentBatches(
+    const SegmentBatch<TPrecision>& lhs,
+    const SegmentBatch<TPrecision>& rhs,
+    std::vector<SegmentIntersectionHit<TPrecision>>& hits
+)
+{
+    std::vector<internal::SegmentBounds<TPrecision>> bounds;
+    bounds.reserve(lhs.size() + rhs.size());
+    internal::appendSegmentBounds(lhs, 0, bounds);
+    internal::appendSegmentBounds(rhs, 1, bounds);
+
+    internal::intersectSegmentCandidates<TVector2D>(
+        lhs,
+        rhs,
+        internal::findOverlappingSegmentBounds(bounds, false),
+        hits
+    );
+}
+
+// Finds all crossings of two polylines, i-th segment joins points i and
+// i + 1. Hits are ordered like in intersectSegmentBatches and parameters
+// are local to segments. Crossing through a vertex is reported for both
+// segments sharing it.
+template <typename TVector2D, typename TPrecision>
+std::vector<SegmentIntersectionHit<TPrecision>> intersectPolylines(
+    const std::vector<TVector2D>& lhs,
+    const std::vector<TVector2D>& rhs
+)
+{
+    std::vector<SegmentIntersectionHit<TPrecision>> hits;
+    intersectSegmentBatches<TVector2D>(
+        internal::createPolylineBatch<TVector2D, TPrecision>(lhs),
+        internal::createPolylineBatch<TVector2D, TPrecision>(rhs),
+        hits
+    );
+
+    return hits;
+}
+
+// Finds all crossings of polyline with itself, lhs index of every hit is
+// lower than rhs index. Consecutive segments (and first and last one of
+// closed polyline, which ends in its first point) are reported only when
+// they overlap, their common vertex is not an intersection.
+template <typename TVector2D, typename TPrecision>
+std::vector<SegmentIntersectionHit<TPrecision>> findSelfIntersections(
+    const std::vector<TVector2D>& points
+)
+{
+    const TPrecision eps = static_cast<TPrecision>(10e-6);
+    auto batch = internal::createPolylineBatch<TVector2D, TPrecision>(points);
+    auto isClosed = points.size() > 2 && points.front() == points.back();
+
+    std::vector<internal::SegmentBounds<TPrecision>> bounds;
+    bounds.reserve(batch.size());
+    internal::appendSegmentBounds(batch, 0, bounds);
+
+    std::vector<SegmentIntersectionHit<TPrecision>> hits;
+    internal::intersectSegmentCandidates<TVector2D>(
+        batch,
+        batch,
+        internal::findOverlappingSegmentBounds(bounds, true),
+        hits
+    );
+
+    hits.erase(
+        std::remove_if(
+            std::begin(hits),
+            std::end(hits),
+            [&](const SegmentIntersectionHit<TPrecision> &hit)
+            {
+                auto isAdjacent = hit.rhsIndex == hit.lhsIndex + 1
+                    || (isClosed
+                        && hit.lhsIndex == 0
+                        && hit.rhsIndex == batch.size() - 1);
+                auto isOverlap = hit.result.t1 - hit.result.t0 > eps;
+                return isAdjacent && !isOverlap;
+            }
+        ),
+        std::end(hits)
+    );
+
+    return hits;
+}
+
+// Tests circle against every circle of the batch, hits are appended with
+// given lhs index and rhs index of batch circle.
+template <typename TVector2D, typename TPrecision>
+void intersectCircleBatch(
+    const TVector2D& origin,
+    TPrecision radius,
+    const CircleBatch<TPrecision>& batch,
+    std::vector<CircleIntersectionHit<TVector2D>>& hits,
+    int lhsIndex = 0,
+    TPrecision epsilon = 10e-6
+)
+{
+    std::uint8_t mayIntersect[internal::BatchChunkSize];
+
+    const auto chunkSize = internal::BatchChunkSize;
+    for (auto first = 0; first < batch.size(); first += chunkSize)
+    {
+        auto count = std::min(chunkSize, batch.size() - first);
+        const auto *originX = batch.originX.data() + first;
+        const auto *originY = batch.originY.data() + first;
+        const auto *radii = batch.radii.data() + first;
+
+        // same rejections as in intersectCircles, before any division
+        for (auto i = 0; i < count; ++i)
+        {
+            auto dx = originX[i] - origin.x;
+            auto dy = originY[i] - origin.y;
+            auto distance = std::sqrt(dx * dx + dy * dy);
+            auto isTooFar = distance > radius + radii[i];
+            auto isInside = distance < std::abs(radius - radii[i]);
+            auto isConcentric = distance < epsilon;
+            mayIntersect[i] = !(isTooFar || isInside || isConcentric);
+        }
+
+        for (auto i = 0; i < count; ++i)
+        {
+            if (!mayIntersect[i])
+            {
+                continue;
+            }
+
+            auto points = intersectCircles<TVector2D, TPrecision>(
+                origin,
+                radius,
+                TVector2D{originX[i], originY[i]},
+                radii[i],
+                epsilon
+            );
+
+            if (points.empty())
+            {
+                continue;
+            }
+
+            CircleIntersectionHit<TVector2D> hit;
+            hit.lhsIndex = lhsIndex;
+            hit.rhsIndex = first + i;
+            hit.numPoints = static_cast<int>(points.size());
+            std::copy(std::begin(points), std::end(points), hit.points);
+            hits.push_back(hit);
+        }
+    }
+}
+
 }
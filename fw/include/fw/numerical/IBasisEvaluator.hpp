@@ -13,6 +13,20 @@ public:
     virtual std::vector<double> evaluate(
         double parameter
     ) const = 0;
+
+    // Amount of basis functions that may be non-zero at any single parameter.
+    // Zero means that evaluator does not support local evaluation.
+    virtual int getSupportSize() const { return 0; }
+
+    // Writes getSupportSize() basis functions starting from
+    // (span - getSupportSize() + 1) into the output buffer and returns span.
+    virtual int evaluateNonVanishing(
+        double /*parameter*/,
+        double * /*output*/
+    ) const
+    {
+        return -1;
+    }
 };
 
 }
@@ -5,6 +5,7 @@
 #include <glm/glm.hpp>
 
 #include <memory>
+#include <vector>
 
 namespace fw
 {
@@ -15,6 +16,37 @@ enum class ParametrizationAxis
     V
 };
 
+// Position and partial derivatives of the surface at single parametrisation.
+// Derivatives above requested order are left zeroed.
+struct SurfaceEvaluation
+{
+    SurfaceEvaluation():
+        order{0},
+        position{},
+        derivativeU{},
+        derivativeV{},
+        derivativeUU{},
+        derivativeUV{},
+        derivativeVV{}
+    {
+    }
+
+    glm::dvec3 getNormal() const
+    {
+        return glm::normalize(glm::cross(derivativeV, derivativeU));
+    }
+
+    int order;
+    glm::dvec3 position;
+    glm::dvec3 derivativeU;
+    glm::dvec3 derivativeV;
+    glm::dvec3 derivativeUU;
+    glm::dvec3 derivativeUV;
+    glm::dvec3 derivativeVV;
+};
+
+// Const evaluation may be called concurrently (mesh building, intersection
+// batches), implementations must not modify shared state in it.
 class IParametricSurfaceUV
 {
 public:
@@ -29,6 +61,100 @@ public:
     virtual glm::dvec3 getNormal(glm::dvec2 parmetrisation) const = 0;
     virtual glm::dvec3 getDerivativeU(glm::dvec2 parametrisation) const = 0;
     virtual glm::dvec3 getDerivativeV(glm::dvec2 parametrisation) const = 0;
+
+    // Periodic axis wraps around its parameter bounds (folded surfaces),
+    // other axes end at them.
+    virtual bool isPeriodic(ParametrizationAxis /*axis*/) const
+    {
+        return false;
+    }
+
+    // Evaluates position and derivatives up to given order (at most 2)
+    // in a single pass.
+    virtual SurfaceEvaluation evaluate(
+        glm::dvec2 parametrisation,
+        int order
+    ) const = 0;
+
+    // Samples surface on a regular grid spanning both parameter bounds
+    // (inclusive). Outputs are stored row by row (V major), normals are
+    // skipped when nullptr is given.
+    void sampleGrid(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        std::vector<glm::dvec3> &positions,
+        std::vector<glm::dvec3> *normals
+    ) const
+    {
+        positions.resize(resolution.x * resolution.y);
+        if (normals != nullptr)
+        {
+            normals->resize(resolution.x * resolution.y);
+        }
+
+        sampleGridRows(
+            minimumParameter,
+            maximumParameter,
+            resolution,
+            0,
+            resolution.y,
+            positions.data(),
+            normals != nullptr ? normals->data() : nullptr
+        );
+    }
+
+    // Samples only rows [firstRow, firstRow + numRows) of the grid described
+    // above. Every sample is computed the same way regardless of requested
+    // rows, so grid may be split into independent parts.
+    virtual void sampleGridRows(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        glm::dvec3 *positions,
+        glm::dvec3 *normals
+    ) const = 0;
+
+    // Same grid as above for display purposes. By default samples are
+    // computed in double precision and converted, surfaces may override it
+    // with cheaper single precision evaluation.
+    virtual void sampleGridRowsSinglePrecision(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        glm::vec3 *positions,
+        glm::vec3 *normals
+    ) const
+    {
+        auto numSamples = numRows * resolution.x;
+        std::vector<glm::dvec3> samplePositions(numSamples);
+        std::vector<glm::dvec3> sampleNormals(
+            normals != nullptr ? numSamples : 0
+        );
+
+        sampleGridRows(
+            minimumParameter,
+            maximumParameter,
+            resolution,
+            firstRow,
+            numRows,
+            samplePositions.data(),
+            normals != nullptr ? sampleNormals.data() : nullptr
+        );
+
+        for (auto i = 0; i < numSamples; ++i)
+        {
+            positions[i] = glm::vec3(samplePositions[i]);
+            if (normals != nullptr)
+            {
+                normals[i] = glm::vec3(sampleNormals[i]);
+            }
+        }
+    }
 };
 
 }
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "fw/AABB.hpp"
+#include "fw/common/ThreadPool.hpp"
+#include "IParametricSurfaceUV.hpp"
+#include "ParametricSurfaceIntersection.hpp"
+#include "ParametricSurfaceIntersectionFinder.hpp"
+
+#include <glm/glm.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace fw
+{
+
+struct IntersectionBatchPair
+{
+public:
+    std::shared_ptr<IParametricSurfaceUV> lhs;
+    std::shared_ptr<IParametricSurfaceUV> rhs;
+    std::vector<AABB<glm::dvec3>> seedRegions;
+    std::vector<IntersectionSeed> seeds;
+};
+
+using IntersectionCurves =
+    std::vector<std::vector<ParametricSurfaceIntersection>>;
+
+// Curves of single pair with stops of their tracing, in the same order.
+struct IntersectionBatchResult
+{
+public:
+    IntersectionCurves curves;
+    std::vector<IntersectionTracingStop> tracingStops;
+};
+
+// Intersects many surface pairs concurrently. Every pair is a separate
+// task with its own finder, results are ordered like added pairs.
+class IntersectionBatch
+{
+public:
+    IntersectionBatch();
+    ~IntersectionBatch();
+
+    void setThreadPool(std::shared_ptr<ThreadPool> threadPool);
+    std::shared_ptr<ThreadPool> getThreadPool() const;
+
+    void setTracingSettings(const IntersectionTracingSettings &settings);
+
+    int addPair(
+        const std::shared_ptr<IParametricSurfaceUV> lhs,
+        const std::shared_ptr<IParametricSurfaceUV> rhs,
+        const std::vector<AABB<glm::dvec3>> &seedRegions
+    );
+
+    int addPair(
+        const std::shared_ptr<IParametricSurfaceUV> lhs,
+        const std::shared_ptr<IParametricSurfaceUV> rhs,
+        const std::vector<IntersectionSeed> &seeds
+    );
+
+    int addPair(
+        const std::shared_ptr<IParametricSurfaceUV> lhs,
+        const std::shared_ptr<IParametricSurfaceUV> rhs,
+        glm::dvec3 neighbourhoodPoint
+    );
+
+    int getNumPairs() const;
+    void clear();
+
+    std::vector<IntersectionBatchResult> run() const;
+
+protected:
+    IntersectionBatchResult intersectPair(
+        const IntersectionBatchPair &pair
+    ) const;
+
+private:
+    std::shared_ptr<ThreadPool> _threadPool;
+    IntersectionTracingSettings _settings;
+    std::vector<IntersectionBatchPair> _pairs;
+};
+
+}
@@ -1,5 +1,8 @@
 #pragma once
 #include "ParametricSurfaceIntersection.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace fw
@@ -22,24 +25,42 @@ public:
     void setLoopbackMinimumIndexDifference(int minIndexDiff);
     void setLoopBackDistance(double loopBackDistance);
 
+    // Points closer along the curve than given arc length are not
+    // connectable, so closely spaced points of tight turns do not loop back.
+    void setLoopBackMinimumArcLength(double minArcLength);
+
     IntersectionCurveAddingResult addCurvePoint(
         const ParametricSurfaceIntersection& intersection
     );
 
     void reverse();
 
-    const std::vector<ParametricSurfaceIntersection> getCurvePoints() const;
+    const std::vector<ParametricSurfaceIntersection> &getCurvePoints() const;
 
 protected:
     int findConnectablePoint(
         const ParametricSurfaceIntersection& intersection
     ) const;
 
+    // Points are indexed in uniform grid of cells not smaller than loop
+    // back distance, so each query visits 3x3x3 cells. Grid is rebuilt
+    // with larger cells when loop back distance outgrows them.
+    void rebuildPointsIndex(double cellSize);
+    void appendCurvePoint(const ParametricSurfaceIntersection& intersection);
+    double getArcLengthTo(const glm::dvec3 &position) const;
+    void addToPointsIndex(int pointIndex);
+    glm::ivec3 getCell(const glm::dvec3 &position) const;
+    static std::int64_t getCellKey(const glm::ivec3 &cell);
+
 private:
     bool _isLoopBackEnabled;
     int _minIndexDiff;
     double _loopBackDistance;
+    double _minArcLength;
+    double _cellSize;
     std::vector<ParametricSurfaceIntersection> _curvePoints;
+    std::vector<double> _arcLengths;
+    std::unordered_map<std::int64_t, std::vector<int>> _pointsIndex;
 };
 
 }
@@ -2,6 +2,8 @@
 
 #include "IBasisEvaluator.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <memory>
 #include <vector>
@@ -28,6 +30,12 @@ public:
 
     TPoint evaluate(TFloating parameter) const
     {
+        auto supportSize = _basisEvaluator->getSupportSize();
+        if (supportSize > 0 && supportSize <= MaxLocalSupportSize)
+        {
+            return evaluateLocally(parameter, supportSize);
+        }
+
         auto basis = _basisEvaluator->evaluate(parameter);
 
         assert(basis.size() > 0);
@@ -43,6 +51,35 @@ public:
     }
 
 private:
+    static constexpr int MaxLocalSupportSize = 16;
+
+    TPoint evaluateLocally(TFloating parameter, int supportSize) const
+    {
+        std::array<double, MaxLocalSupportSize> basis;
+        auto span = _basisEvaluator->evaluateNonVanishing(
+            parameter,
+            basis.data()
+        );
+
+        if (span < 0)
+        {
+            return 0.0 * _controlPoints[0];
+        }
+
+        auto firstIndex = span - supportSize + 1;
+        auto controlPointsCount = static_cast<int>(_controlPoints.size());
+
+        TPoint output = 0.0 * _controlPoints[0];
+        for (auto i = std::max(0, -firstIndex); i < supportSize; ++i)
+        {
+            auto controlPointIndex = firstIndex + i;
+            if (controlPointIndex >= controlPointsCount) { break; }
+            output += basis[i] * _controlPoints[controlPointIndex];
+        }
+
+        return output;
+    }
+
     std::shared_ptr<IBasisEvaluator> _basisEvaluator;
     std::vector<TPoint> _controlPoints;
 };
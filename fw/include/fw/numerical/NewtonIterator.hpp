@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 namespace fw
 {
 
@@ -14,6 +16,7 @@ public:
     virtual bool hasParameterConverged(const TDomain& newParameters) const = 0;
     virtual bool areParametersValid(const TDomain& parameters) const = 0;
     virtual TCodomain evaluateFunction() const = 0;
+    virtual TDomainTransformation getJacobian() const = 0;
     virtual TDomainTransformation getJacobianInverse() const = 0;
     virtual TDomain correctParametrisation(const TDomain& parameters) const = 0;
 };
@@ -24,6 +27,17 @@ enum class NewtonIterationExitStatus
     Success,
     IterationLimitReached,
     InvalidParameterReached,
+    SingularJacobian,
+    LineSearchFailed,
+};
+
+// Single accepted step of iteration, step length is measured in domain.
+struct NewtonIterationStep
+{
+public:
+    double stepLength;
+    double stepScale;
+    double residualNorm;
 };
 
 template <typename TDomain>
@@ -33,27 +47,37 @@ public:
     NewtonIterationResult();
     NewtonIterationResult(
         NewtonIterationExitStatus exitStatus,
-        TDomain parameters
+        TDomain parameters,
+        int iterations = 0
     );
 
     NewtonIterationExitStatus exitStatus;
     TDomain parameters;
+    int iterations;
+    // Norm of function at returned parameters, negative when not computed.
+    double residualNorm;
+    std::vector<NewtonIterationStep> history;
 };
 
 template <typename TDomain>
 NewtonIterationResult<TDomain>::NewtonIterationResult():
     exitStatus{NewtonIterationExitStatus::Unknown},
-    parameters{}
+    parameters{},
+    iterations{0},
+    residualNorm{-1.0}
 {
 }
 
 template <typename TDomain>
 NewtonIterationResult<TDomain>::NewtonIterationResult(
     NewtonIterationExitStatus exitStatus,
-    TDomain parameters
+    TDomain parameters,
+    int iterations
 ):
     exitStatus{exitStatus},
-    parameters{parameters}
+    parameters{parameters},
+    iterations{iterations},
+    residualNorm{-1.0}
 {
 }
 
@@ -107,6 +131,7 @@ NewtonIterationResult<TDomain>
 ) const
 {
     auto iteration = 0;
+    auto performedSteps = 0;
     auto currentParameters = startParameters;
 
     iterable.setInitialParameters(currentParameters);
@@ -120,6 +145,7 @@ NewtonIterationResult<TDomain>
         auto jacobianInv = iterable.getJacobianInverse();
         currentParameters -= jacobianInv * functionValue;
         currentParameters = iterable.correctParametrisation(currentParameters);
+        ++performedSteps;
     }
     while (
         (lastParameterValidity = iterable.areParametersValid(currentParameters))
@@ -138,7 +164,7 @@ NewtonIterationResult<TDomain>
         exitStatus = NewtonIterationExitStatus::InvalidParameterReached;
     }
 
-    return {exitStatus, currentParameters};
+    return {exitStatus, currentParameters, performedSteps};
 }
 
 }
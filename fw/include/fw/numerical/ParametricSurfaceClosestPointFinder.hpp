@@ -0,0 +1,50 @@
+#pragma once
+
+#include "IParametricSurfaceUV.hpp"
+#include <glm/glm.hpp>
+
+namespace fw
+{
+
+// Finds closest point by sampling surface coarsely and refining best few
+// samples with Newton iterations minimizing squared distance (point
+// inversion). Surfaces evaluating only first derivatives are refined with
+// Gauss-Newton steps. ParametricSurfaceClosestPointNaiveFinder remains
+// reference.
+class ParametricSurfaceClosestPointFinder
+{
+public:
+    ParametricSurfaceClosestPointFinder();
+    virtual ~ParametricSurfaceClosestPointFinder();
+
+    void setReferencePoint(glm::dvec3 referencePoint);
+    void setSamplingResolution(glm::ivec2 samplingResolution);
+    void setCandidatesAmount(int candidatesAmount);
+    void setIterationLimit(int iterationLimit);
+    void setTolerance(double tolerance);
+
+    // Wrapped axes are periodic (folded surfaces), others are clamped
+    // to [0, 1].
+    void setDomainWrapping(bool wrapU, bool wrapV);
+
+    glm::dvec2 find(const IParametricSurfaceUV& surface) const;
+
+protected:
+    glm::dvec2 refine(
+        const IParametricSurfaceUV& surface,
+        glm::dvec2 parameters
+    ) const;
+
+    glm::dvec2 correctParameters(glm::dvec2 parameters) const;
+
+private:
+    glm::dvec3 _referencePoint;
+    glm::ivec2 _samplingResolution;
+    int _candidatesAmount;
+    int _iterationLimit;
+    double _tolerance;
+    bool _wrapU;
+    bool _wrapV;
+};
+
+}
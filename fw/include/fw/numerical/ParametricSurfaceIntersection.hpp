@@ -1,4 +1,5 @@
 #pragma once
+#include "fw/AABB.hpp"
 #include <glm/glm.hpp>
 
 namespace fw
@@ -19,4 +20,17 @@ public:
     glm::dvec3 scenePosition;
 };
 
+// Starting point for intersection tracing, for example centres of parameter
+// ranges of overlapping patch pair. Overlap bounds the scene region where
+// the pair may intersect, seeds sharing region index belong to the same
+// merged seed region.
+struct IntersectionSeed
+{
+public:
+    glm::dvec2 lhsParameters;
+    glm::dvec2 rhsParameters;
+    AABB<glm::dvec3> overlap;
+    int region;
+};
+
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "fw/AABB.hpp"
 #include "IParametricSurfaceUV.hpp"
 #include "ParametricSurfaceIntersection.hpp"
 #include "IntersectionCurve.hpp"
@@ -12,20 +13,114 @@
 namespace fw
 {
 
+// Controls marching along intersection curve. Step grows when Newton
+// converges quickly and curve turns little, shrinks on failures and sharp
+// turns. Steps and distances are given in scene units, angles in radians.
+// Newton iterations include final step that only confirms convergence.
+struct IntersectionTracingSettings
+{
+public:
+    IntersectionTracingSettings();
+
+    double initialStep;
+    double minimumStep;
+    double maximumStep;
+    double stepGrowthFactor;
+    double stepShrinkFactor;
+    double maximumTurnAngle;
+    int fastConvergenceIterations;
+    int newtonIterationLimit;
+    double convergenceThreshold;
+    double loopBackDistance;
+    int stepLimit;
+};
+
+// Why tracing in one direction ended. Newton statuses are reported when
+// the step could not be shrunk further.
+enum class IntersectionTracingStopReason
+{
+    Unknown,
+    LoopClosed,
+    StepLimitReached,
+    SurfacesTangent,
+    MinimumStepReached,
+    IterationLimitReached,
+    InvalidParameterReached,
+    SingularJacobian,
+    LineSearchFailed
+};
+
+// Stop reasons of both curve ends, backward one is not traced when the
+// forward tracing closes the loop.
+struct IntersectionTracingStop
+{
+public:
+    IntersectionTracingStopReason forward;
+    IntersectionTracingStopReason backward;
+};
+
 class ParametricSurfaceIntersectionFinder
 {
 public:
     ParametricSurfaceIntersectionFinder();
     virtual ~ParametricSurfaceIntersectionFinder();
 
+    const IntersectionTracingSettings &getTracingSettings() const;
+    void setTracingSettings(const IntersectionTracingSettings &settings);
+
+    // Amount of Newton solves performed by last intersect call.
+    int getNewtonSolvesCount() const;
+
+    // Newton iterations summed over all solves of last intersect call.
+    int getNewtonIterationsCount() const;
+
+    // Stops of every curve returned by last intersect call, in the same
+    // order as curves.
+    const std::vector<IntersectionTracingStop> &getTracingStops() const;
+
     std::vector<ParametricSurfaceIntersection> intersect(
         const std::shared_ptr<IParametricSurfaceUV> lhs,
         const std::shared_ptr<IParametricSurfaceUV> rhs,
         glm::vec3 neighbourhoodPoint
     );
 
+    // Traces intersection starting from points of both surfaces closest to
+    // centre of every seed region. Regions already crossed by traced curves
+    // are skipped, so each curve is reported once.
+    std::vector<std::vector<ParametricSurfaceIntersection>> intersect(
+        const std::shared_ptr<IParametricSurfaceUV> lhs,
+        const std::shared_ptr<IParametricSurfaceUV> rhs,
+        const std::vector<AABB<glm::dvec3>> &seedRegions
+    );
+
+    // Traces intersection starting from seed parameters (for example found
+    // by BsplineSurfacePatchHierarchy), seeds are expected to be ordered by
+    // region. Every seed is moved onto the intersection and traced unless it
+    // lands on curve already traced from its region, so each curve is
+    // reported once.
+    std::vector<std::vector<ParametricSurfaceIntersection>> intersect(
+        const std::shared_ptr<IParametricSurfaceUV> lhs,
+        const std::shared_ptr<IParametricSurfaceUV> rhs,
+        const std::vector<IntersectionSeed> &seeds
+    );
+
 protected:
-    bool iterateInDirection(
+    std::vector<ParametricSurfaceIntersection> trace(
+        const std::shared_ptr<IParametricSurfaceUV> lhs,
+        const std::shared_ptr<IParametricSurfaceUV> rhs,
+        glm::dvec2 lhsParameters,
+        glm::dvec2 rhsParameters
+    );
+
+    // Moves parameters onto the intersection within plane perpendicular to
+    // the curve direction estimated at them.
+    bool findNearestIntersection(
+        const std::shared_ptr<IParametricSurfaceUV> lhs,
+        const std::shared_ptr<IParametricSurfaceUV> rhs,
+        glm::dvec4 &parameters
+    );
+
+    IntersectionTracingStopReason iterateInDirection(
         double tangentMultipler,
         glm::dvec2 initialLhsParams,
         glm::dvec2 initialRhsParams
@@ -34,9 +129,13 @@ protected:
     std::shared_ptr<IParametricSurfaceUV> _lhs;
     std::shared_ptr<IParametricSurfaceUV> _rhs;
 
-    SurfaceIntersectionNewtonIterator _newtonIterator;
+    SurfaceIntersectionDampedNewtonIterator _newtonIterator;
     SurfaceIntersectionNewtonIterable _newtonIterable;
     IntersectionCurve _intersectionCurve;
+    IntersectionTracingSettings _settings;
+    int _newtonSolvesCount;
+    int _newtonIterationsCount;
+    std::vector<IntersectionTracingStop> _tracingStops;
 };
 
 }
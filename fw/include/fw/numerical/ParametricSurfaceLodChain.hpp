@@ -0,0 +1,90 @@
+#pragma once
+
+#include <future>
+#include <memory>
+#include <vector>
+#include <glm/glm.hpp>
+#include "fw/AABB.hpp"
+#include "fw/common/ThreadPool.hpp"
+#include "IParametricSurfaceUV.hpp"
+#include "Mesh.hpp"
+#include "Vertices.hpp"
+
+namespace fw
+{
+
+// Uniform tessellations of a surface at several resolutions, ordered from
+// the coarsest. Levels are built on first request, on thread pool when it
+// is set. Meshes are created from finished levels by getMesh, so it has to
+// be called from the thread owning GL context.
+class ParametricSurfaceLodChain
+{
+public:
+    ParametricSurfaceLodChain(
+        std::shared_ptr<IParametricSurfaceUV> surface,
+        std::vector<glm::ivec2> resolutions,
+        glm::dvec2 minimumParameter = glm::dvec2(0.0, 0.0),
+        glm::dvec2 maximumParameter = glm::dvec2(1.0, 1.0)
+    );
+
+    ~ParametricSurfaceLodChain();
+
+    ParametricSurfaceLodChain(const ParametricSurfaceLodChain &) = delete;
+    ParametricSurfaceLodChain &operator=(
+        const ParametricSurfaceLodChain &
+    ) = delete;
+
+    void setThreadPool(std::shared_ptr<ThreadPool> threadPool);
+    std::shared_ptr<ThreadPool> getThreadPool() const;
+
+    // Desired distance between neighbouring vertices on screen.
+    void setPixelsPerSample(double pixelsPerSample);
+    double getPixelsPerSample() const;
+
+    int getNumLevels() const;
+    glm::ivec2 getResolution(int level) const;
+
+    // Bounds of coarse sampling of the surface, used for level selection.
+    const AABB<glm::dvec3> &getBounds() const;
+
+    // Coarsest level for which vertex spacing of projected bounds does not
+    // exceed pixels per sample. Finest level is chosen when bounds cross
+    // the plane of the eye and coarsest one when they lie behind the eye.
+    int selectLevel(
+        const glm::mat4 &modelViewProjection,
+        glm::ivec2 viewportSize
+    ) const;
+
+    void requestLevel(int level);
+    bool isLevelBuilt(int level) const;
+    void waitForLevel(int level) const;
+
+    // Mesh of given level or, until it is built, of the closest built one
+    // (coarser first). Returns nullptr when no level is built yet.
+    std::shared_ptr<Mesh<VertexNormalTexCoords>> getMesh(int level);
+
+private:
+    struct Level
+    {
+    public:
+        glm::ivec2 resolution;
+        bool requested;
+        std::future<void> building;
+        std::vector<VertexNormalTexCoords> vertices;
+        std::vector<GLuint> indices;
+        std::shared_ptr<Mesh<VertexNormalTexCoords>> mesh;
+    };
+
+    void buildLevel(Level &level) const;
+    void createMeshes();
+
+    std::shared_ptr<IParametricSurfaceUV> _surface;
+    glm::dvec2 _minimumParameter;
+    glm::dvec2 _maximumParameter;
+    std::shared_ptr<ThreadPool> _threadPool;
+    double _pixelsPerSample;
+    AABB<glm::dvec3> _bounds;
+    std::vector<Level> _levels;
+};
+
+}
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 #include <glm/glm.hpp>
+#include "fw/AABB.hpp"
 #include "IParametricSurfaceUV.hpp"
 #include "Mesh.hpp"
 #include "Vertices.hpp"
+#include "fw/common/ThreadPool.hpp"
 
 namespace fw
 {
@@ -18,14 +21,75 @@ public:
     void setSamplingResolution(glm::ivec2 samplingResolution);
     glm::ivec2 getSamplingResolution() const;
 
+    // Rows of vertices and indices are built concurrently when pool is set.
+    // Output does not depend on the pool or its size.
+    void setThreadPool(std::shared_ptr<ThreadPool> threadPool);
+    std::shared_ptr<ThreadPool> getThreadPool() const;
+
+    // Meshes later changed by update should be built with GL_DYNAMIC_DRAW
+    // usage.
     std::shared_ptr<Mesh<VertexNormalTexCoords>> build(
         std::shared_ptr<IParametricSurfaceUV> surface,
         glm::dvec2 minimumParameter = glm::dvec2(0.0, 0.0),
+        glm::dvec2 maximumParmeter = glm::dvec2(1.0, 1.0),
+        GLenum usage = GL_STATIC_DRAW
+    ) const;
+
+    void buildGeometry(
+        const IParametricSurfaceUV &surface,
+        std::vector<VertexNormalTexCoords> &vertices,
+        std::vector<GLuint> &indices,
+        glm::dvec2 minimumParameter = glm::dvec2(0.0, 0.0),
+        glm::dvec2 maximumParmeter = glm::dvec2(1.0, 1.0)
+    ) const;
+
+    // Recomputes vertices of grid built by buildGeometry with the same
+    // resolution and parameter bounds, only samples within changedRegion
+    // of parametrisation are evaluated. Returns inclusive range of updated
+    // grid samples, invalid when nothing was updated. Indices are unchanged.
+    AABB<glm::ivec2> updateGeometry(
+        const IParametricSurfaceUV &surface,
+        const AABB<glm::dvec2> &changedRegion,
+        std::vector<VertexNormalTexCoords> &vertices,
+        glm::dvec2 minimumParameter = glm::dvec2(0.0, 0.0),
         glm::dvec2 maximumParmeter = glm::dvec2(1.0, 1.0)
     ) const;
 
+    // Updates vertices as above and uploads only changed ones into mesh
+    // created from them, preferably with GL_DYNAMIC_DRAW usage.
+    void update(
+        const IParametricSurfaceUV &surface,
+        const AABB<glm::dvec2> &changedRegion,
+        std::vector<VertexNormalTexCoords> &vertices,
+        Mesh<VertexNormalTexCoords> &mesh,
+        glm::dvec2 minimumParameter = glm::dvec2(0.0, 0.0),
+        glm::dvec2 maximumParmeter = glm::dvec2(1.0, 1.0)
+    ) const;
+
+protected:
+    void updateRows(
+        const IParametricSurfaceUV &surface,
+        const AABB<glm::ivec2> &samples,
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        int firstRow,
+        int lastRow,
+        std::vector<VertexNormalTexCoords> &vertices
+    ) const;
+
+    void buildRows(
+        const IParametricSurfaceUV &surface,
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        int firstRow,
+        int lastRow,
+        std::vector<VertexNormalTexCoords> &vertices,
+        std::vector<GLuint> &indices
+    ) const;
+
 private:
     glm::ivec2 _samplingResolution;
+    std::shared_ptr<ThreadPool> _threadPool;
 };
 
 }
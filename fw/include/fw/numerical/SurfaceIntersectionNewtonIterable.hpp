@@ -1,4 +1,5 @@
 #pragma once
+#include "DampedNewtonIterator.hpp"
 #include "NewtonIterator.hpp"
 #include "IParametricSurfaceUV.hpp"
 #include <glm/glm.hpp>
@@ -10,6 +11,9 @@ namespace fw
 using SurfaceIntersectionNewtonIterator =
     NewtonIterator<glm::dvec4, glm::dvec4, glm::dmat4>;
 
+using SurfaceIntersectionDampedNewtonIterator =
+    DampedNewtonIterator<glm::dvec4, glm::dvec4, glm::dmat4>;
+
 class SurfaceIntersectionNewtonIterable:
     public INewtonIterable<glm::dvec4, glm::dvec4, glm::dmat4>
 {
@@ -24,6 +28,11 @@ public:
     void setTangentVector(const glm::dvec3& tangentVector);
     void setPlaneDistance(double planeDistance);
 
+    // Debug option, tangent plane constraint derivatives are computed with
+    // finite differences instead of surface derivatives.
+    bool isUsingNumericPlaneDerivatives() const;
+    void setUsingNumericPlaneDerivatives(bool useNumericDerivatives);
+
     double getCovergenceThreshold() const;
     void setCovergenceThreshold(double threshold);
 
@@ -36,6 +45,7 @@ public:
         const glm::dvec4& newParameters
     ) const override;
     virtual glm::dvec4 evaluateFunction() const override;
+    virtual glm::dmat4 getJacobian() const override;
     virtual glm::dmat4 getJacobianInverse() const override;
     virtual glm::dvec4 correctParametrisation(
         const glm::dvec4& parameters
@@ -44,6 +54,7 @@ public:
 private:
     double calculateTangentPlaneDistance(const glm::dvec3& lhsPosition) const;
     glm::dvec4 getTangentPlaneDerivatives() const;
+    glm::dvec4 getNumericTangentPlaneDerivatives() const;
     double calculateTangentPlaneSingleDerivative(
         const glm::dvec2 &lhsParams,
         const glm::dvec2& direction,
@@ -55,12 +66,15 @@ private:
         const glm::dvec2& current
     ) const;
 
+    bool _useNumericPlaneDerivatives;
     double _planeDistance;
     double _covergenceThreshold;
     glm::dvec4 _initialParameters;
     glm::dvec4 _parameters;
     glm::dvec3 _initialLhsPosition;
     glm::dvec3 _tangentVector;
+    SurfaceEvaluation _lhsEvaluation;
+    SurfaceEvaluation _rhsEvaluation;
     std::shared_ptr<IParametricSurfaceUV> _lhsSurface;
     std::shared_ptr<IParametricSurfaceUV> _rhsSurface;
 };
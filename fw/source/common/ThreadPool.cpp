@@ -0,0 +1,126 @@
+#include "fw/common/ThreadPool.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace fw
+{
+
+ThreadPool::ThreadPool(int numThreads):
+    _stopping{false}
+{
+    for (auto i = 0; i < numThreads; ++i)
+    {
+        _workers.emplace_back([this]() { processTasks(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stopping = true;
+    }
+
+    _condition.notify_all();
+
+    for (auto &worker: _workers)
+    {
+        worker.join();
+    }
+}
+
+int ThreadPool::getDefaultNumThreads()
+{
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+int ThreadPool::getNumThreads() const
+{
+    return static_cast<int>(_workers.size());
+}
+
+std::future<void> ThreadPool::enqueue(std::function<void()> task)
+{
+    auto packagedTask = std::make_shared<std::packaged_task<void()>>(task);
+    auto future = packagedTask->get_future();
+
+    if (_workers.empty())
+    {
+        (*packagedTask)();
+        return future;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _tasks.emplace([packagedTask]() { (*packagedTask)(); });
+    }
+
+    _condition.notify_one();
+    return future;
+}
+
+void ThreadPool::parallelFor(
+    int begin,
+    int end,
+    const std::function<void(int rangeBegin, int rangeEnd)> &body
+)
+{
+    auto length = end - begin;
+    if (length <= 0) { return; }
+
+    // few ranges per worker smooth out uneven range costs
+    auto numRanges = std::min(length, std::max(1, 4 * getNumThreads()));
+
+    std::vector<std::future<void>> pendingRanges;
+    pendingRanges.reserve(numRanges);
+
+    for (auto i = 0; i < numRanges; ++i)
+    {
+        auto rangeBegin = begin + static_cast<int>(
+            static_cast<long long>(length) * i / numRanges
+        );
+        auto rangeEnd = begin + static_cast<int>(
+            static_cast<long long>(length) * (i + 1) / numRanges
+        );
+
+        pendingRanges.push_back(enqueue([&body, rangeBegin, rangeEnd]() {
+            body(rangeBegin, rangeEnd);
+        }));
+    }
+
+    // every range has to finish before rethrowing, body is referenced
+    for (auto &pendingRange: pendingRanges)
+    {
+        pendingRange.wait();
+    }
+
+    for (auto &pendingRange: pendingRanges)
+    {
+        pendingRange.get();
+    }
+}
+
+void ThreadPool::processTasks()
+{
+    while (true)
+    {
+        std::function<void()> task;
+
+        {
+            std::unique_lock<std::mutex> lock{_mutex};
+            _condition.wait(lock, [this]() {
+                return _stopping || !_tasks.empty();
+            });
+
+            if (_stopping && _tasks.empty()) { return; }
+
+            task = std::move(_tasks.front());
+            _tasks.pop();
+        }
+
+        task();
+    }
+}
+
+}
@@ -0,0 +1,22 @@
+#include "fw/models/SurfaceLodMesh.hpp"
+
+namespace fw
+{
+
+SurfaceLodMesh::SurfaceLodMesh():
+    _lodChain{}
+{
+}
+
+SurfaceLodMesh::SurfaceLodMesh(
+    std::shared_ptr<ParametricSurfaceLodChain> lodChain
+):
+    _lodChain{lodChain}
+{
+}
+
+SurfaceLodMesh::~SurfaceLodMesh()
+{
+}
+
+}
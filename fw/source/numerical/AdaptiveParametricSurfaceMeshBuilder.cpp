@@ -0,0 +1,537 @@
+#include "fw/numerical/AdaptiveParametricSurfaceMeshBuilder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fw
+{
+
+namespace
+{
+
+struct QuadtreeCell
+{
+public:
+    int level;
+    int x;
+    int y;
+};
+
+struct TessellationSample
+{
+public:
+    glm::dvec3 position;
+    glm::dvec3 normal;
+    glm::vec2 texCoords;
+};
+
+// Quadtree over grid of root cells. Cells are addressed by level and index
+// in the uniform grid of that level, corners of all cells lie on a lattice
+// one level finer than the deepest level, so cell centres are on it too.
+class QuadtreeTessellation
+{
+public:
+    QuadtreeTessellation(
+        const IParametricSurfaceUV &surface,
+        const AdaptiveTessellationSettings &settings,
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter
+    );
+
+    void refine();
+    void balance();
+    void triangulate(
+        std::vector<VertexNormalTexCoords> &vertices,
+        std::vector<GLuint> &indices
+    );
+
+private:
+    static std::int64_t getCellKey(const QuadtreeCell &cell);
+    static QuadtreeCell getCell(std::int64_t key);
+
+    bool isInside(const QuadtreeCell &cell) const;
+    bool isLeaf(const QuadtreeCell &cell) const;
+    bool findCoveringLeaf(
+        const QuadtreeCell &cell,
+        QuadtreeCell &leaf
+    ) const;
+    bool hasFinerNeighbour(const QuadtreeCell &cell, glm::ivec2 side) const;
+    bool needsSplitForBalance(const QuadtreeCell &cell) const;
+
+    void split(const QuadtreeCell &cell, std::vector<QuadtreeCell> &output);
+    bool exceedsError(const QuadtreeCell &cell);
+
+    glm::ivec2 getLatticeCorner(const QuadtreeCell &cell) const;
+    int getLatticeCellSize(const QuadtreeCell &cell) const;
+    int getSample(glm::ivec2 latticePoint);
+
+    const IParametricSurfaceUV &_surface;
+    const AdaptiveTessellationSettings &_settings;
+    glm::dvec2 _minimumParameter;
+    glm::dvec2 _maximumParameter;
+    glm::ivec2 _latticeSize;
+
+    std::unordered_set<std::int64_t> _leaves;
+    std::unordered_map<std::int64_t, int> _sampleIndices;
+    std::vector<TessellationSample> _samples;
+};
+
+const glm::ivec2 CellSides[] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}};
+
+QuadtreeTessellation::QuadtreeTessellation(
+    const IParametricSurfaceUV &surface,
+    const AdaptiveTessellationSettings &settings,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter
+):
+    _surface(surface),
+    _settings(settings),
+    _minimumParameter{minimumParameter},
+    _maximumParameter{maximumParameter},
+    _latticeSize{settings.initialResolution * (2 << settings.maximumDepth)}
+{
+}
+
+void QuadtreeTessellation::refine()
+{
+    std::vector<QuadtreeCell> stack;
+    for (auto y = 0; y < _settings.initialResolution.y; ++y)
+    {
+        for (auto x = 0; x < _settings.initialResolution.x; ++x)
+        {
+            stack.push_back({0, x, y});
+        }
+    }
+
+    while (!stack.empty())
+    {
+        auto cell = stack.back();
+        stack.pop_back();
+
+        if (cell.level < _settings.maximumDepth && exceedsError(cell))
+        {
+            for (auto child = 0; child < 4; ++child)
+            {
+                stack.push_back({
+                    cell.level + 1,
+                    2 * cell.x + child % 2,
+                    2 * cell.y + child / 2
+                });
+            }
+        }
+        else
+        {
+            _leaves.insert(getCellKey(cell));
+        }
+    }
+}
+
+void QuadtreeTessellation::balance()
+{
+    std::vector<QuadtreeCell> worklist;
+    worklist.reserve(_leaves.size());
+    for (auto key: _leaves)
+    {
+        worklist.push_back(getCell(key));
+    }
+
+    while (!worklist.empty())
+    {
+        auto cell = worklist.back();
+        worklist.pop_back();
+
+        if (!isLeaf(cell) || !needsSplitForBalance(cell))
+        {
+            continue;
+        }
+
+        split(cell, worklist);
+
+        // coarser neighbours may now be two levels apart from new cells
+        for (const auto &side: CellSides)
+        {
+            QuadtreeCell neighbour{
+                cell.level,
+                cell.x + side.x,
+                cell.y + side.y
+            };
+
+            QuadtreeCell leaf;
+            if (isInside(neighbour) && findCoveringLeaf(neighbour, leaf))
+            {
+                worklist.push_back(leaf);
+            }
+        }
+    }
+}
+
+void QuadtreeTessellation::triangulate(
+    std::vector<VertexNormalTexCoords> &vertices,
+    std::vector<GLuint> &indices
+)
+{
+    // sorted so that output does not depend on hashing order
+    std::vector<std::int64_t> leaves(std::begin(_leaves), std::end(_leaves));
+    std::sort(std::begin(leaves), std::end(leaves));
+
+    std::vector<int> outputIndices;
+    auto getVertex = [&](glm::ivec2 latticePoint) -> GLuint {
+        auto sample = getSample(latticePoint);
+        if (sample >= static_cast<int>(outputIndices.size()))
+        {
+            outputIndices.resize(sample + 1, -1);
+        }
+
+        if (outputIndices[sample] < 0)
+        {
+            outputIndices[sample] = static_cast<int>(vertices.size());
+            const auto &data = _samples[sample];
+            vertices.push_back({
+                glm::vec3(data.position),
+                glm::vec3(data.normal),
+                data.texCoords
+            });
+        }
+
+        return static_cast<GLuint>(outputIndices[sample]);
+    };
+
+    vertices.clear();
+    indices.clear();
+
+    for (auto key: leaves)
+    {
+        auto cell = getCell(key);
+        auto corner = getLatticeCorner(cell);
+        auto size = getLatticeCellSize(cell);
+        auto half = size / 2;
+
+        // perimeter in counter-clockwise order, edge midpoints are added
+        // only where neighbour is finer
+        const glm::ivec2 perimeter[] = {
+            {0, 0}, {half, 0}, {size, 0}, {size, half},
+            {size, size}, {half, size}, {0, size}, {0, half}
+        };
+        const glm::ivec2 midpointSides[] = {{0, -1}, {1, 0}, {0, 1}, {-1, 0}};
+
+        std::vector<GLuint> fan;
+        for (auto i = 0; i < 8; ++i)
+        {
+            if (i % 2 == 1 && !hasFinerNeighbour(cell, midpointSides[i / 2]))
+            {
+                continue;
+            }
+
+            fan.push_back(getVertex(corner + perimeter[i]));
+        }
+
+        if (fan.size() == 4)
+        {
+            indices.insert(std::end(indices), {fan[0], fan[1], fan[3]});
+            indices.insert(std::end(indices), {fan[1], fan[2], fan[3]});
+            continue;
+        }
+
+        auto centre = getVertex(corner + glm::ivec2{half, half});
+        auto numFanVertices = static_cast<int>(fan.size());
+        for (auto i = 0; i < numFanVertices; ++i)
+        {
+            indices.insert(
+                std::end(indices),
+                {centre, fan[i], fan[(i + 1) % numFanVertices]}
+            );
+        }
+    }
+}
+
+std::int64_t QuadtreeTessellation::getCellKey(const QuadtreeCell &cell)
+{
+    return (static_cast<std::int64_t>(cell.level) << 58)
+        | (static_cast<std::int64_t>(cell.y) << 29)
+        | static_cast<std::int64_t>(cell.x);
+}
+
+QuadtreeCell QuadtreeTessellation::getCell(std::int64_t key)
+{
+    const std::int64_t mask = (std::int64_t{1} << 29) - 1;
+    return {
+        static_cast<int>(key >> 58),
+        static_cast<int>(key & mask),
+        static_cast<int>((key >> 29) & mask)
+    };
+}
+
+bool QuadtreeTessellation::isInside(const QuadtreeCell &cell) const
+{
+    auto resolution = _settings.initialResolution * (1 << cell.level);
+    return cell.x >= 0 && cell.y >= 0
+        && cell.x < resolution.x && cell.y < resolution.y;
+}
+
+bool QuadtreeTessellation::isLeaf(const QuadtreeCell &cell) const
+{
+    return _leaves.find(getCellKey(cell)) != std::end(_leaves);
+}
+
+bool QuadtreeTessellation::findCoveringLeaf(
+    const QuadtreeCell &cell,
+    QuadtreeCell &leaf
+) const
+{
+    for (auto level = cell.level; level >= 0; --level)
+    {
+        auto shift = cell.level - level;
+        QuadtreeCell ancestor{level, cell.x >> shift, cell.y >> shift};
+        if (isLeaf(ancestor))
+        {
+            leaf = ancestor;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool QuadtreeTessellation::hasFinerNeighbour(
+    const QuadtreeCell &cell,
+    glm::ivec2 side
+) const
+{
+    QuadtreeCell neighbour{cell.level, cell.x + side.x, cell.y + side.y};
+    QuadtreeCell leaf;
+    return isInside(neighbour) && !findCoveringLeaf(neighbour, leaf);
+}
+
+bool QuadtreeTessellation::needsSplitForBalance(
+    const QuadtreeCell &cell
+) const
+{
+    for (const auto &side: CellSides)
+    {
+        if (!hasFinerNeighbour(cell, side))
+        {
+            continue;
+        }
+
+        // children of finer neighbour touching the cell must be leaves
+        QuadtreeCell neighbour{cell.level, cell.x + side.x, cell.y + side.y};
+        auto along = glm::ivec2{side.y != 0 ? 1 : 0, side.x != 0 ? 1 : 0};
+        auto touching = glm::ivec2{
+            side.x < 0 ? 1 : 0,
+            side.y < 0 ? 1 : 0
+        };
+
+        for (auto i = 0; i < 2; ++i)
+        {
+            auto offset = touching + i * along;
+            QuadtreeCell child{
+                cell.level + 1,
+                2 * neighbour.x + offset.x,
+                2 * neighbour.y + offset.y
+            };
+
+            if (!isLeaf(child))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void QuadtreeTessellation::split(
+    const QuadtreeCell &cell,
+    std::vector<QuadtreeCell> &output
+)
+{
+    _leaves.erase(getCellKey(cell));
+    for (auto child = 0; child < 4; ++child)
+    {
+        QuadtreeCell childCell{
+            cell.level + 1,
+            2 * cell.x + child % 2,
+            2 * cell.y + child / 2
+        };
+
+        _leaves.insert(getCellKey(childCell));
+        output.push_back(childCell);
+    }
+}
+
+bool QuadtreeTessellation::exceedsError(const QuadtreeCell &cell)
+{
+    auto corner = getLatticeCorner(cell);
+    auto size = getLatticeCellSize(cell);
+    auto half = size / 2;
+
+    // copied, as sampling may reallocate samples
+    auto c00 = _samples[getSample(corner)].position;
+    auto c10 = _samples[getSample(corner + glm::ivec2{size, 0})].position;
+    auto c01 = _samples[getSample(corner + glm::ivec2{0, size})].position;
+    auto c11 = _samples[getSample(corner + glm::ivec2{size, size})].position;
+
+    // surface at centre and edge midpoints against bilinear interpolation
+    // of corners
+    const glm::ivec2 offsets[] = {
+        {half, half}, {half, 0}, {size, half}, {half, size}, {0, half}
+    };
+    const glm::dvec3 approximations[] = {
+        0.25 * (c00 + c10 + c01 + c11),
+        0.5 * (c00 + c10),
+        0.5 * (c10 + c11),
+        0.5 * (c01 + c11),
+        0.5 * (c00 + c01)
+    };
+
+    auto chordHeight = 0.0;
+    for (auto i = 0; i < 5; ++i)
+    {
+        auto sample = getSample(corner + offsets[i]);
+        chordHeight = std::max(
+            chordHeight,
+            glm::length(_samples[sample].position - approximations[i])
+        );
+    }
+
+    if (!_settings.useScreenSpaceError)
+    {
+        return chordHeight > _settings.chordHeightTolerance;
+    }
+
+    auto centre = _samples[getSample(corner + offsets[0])].position;
+    auto distance = std::max(
+        glm::length(centre - _settings.eyePosition),
+        1e-9
+    );
+
+    auto projectedError = chordHeight * _settings.projectionScale / distance;
+    return projectedError > _settings.screenSpaceTolerance;
+}
+
+glm::ivec2 QuadtreeTessellation::getLatticeCorner(
+    const QuadtreeCell &cell
+) const
+{
+    return glm::ivec2{cell.x, cell.y} * getLatticeCellSize(cell);
+}
+
+int QuadtreeTessellation::getLatticeCellSize(const QuadtreeCell &cell) const
+{
+    return 2 << (_settings.maximumDepth - cell.level);
+}
+
+int QuadtreeTessellation::getSample(glm::ivec2 latticePoint)
+{
+    auto key = static_cast<std::int64_t>(latticePoint.y)
+        * (_latticeSize.x + 1) + latticePoint.x;
+
+    auto it = _sampleIndices.find(key);
+    if (it != std::end(_sampleIndices))
+    {
+        return it->second;
+    }
+
+    auto texCoords = glm::dvec2{latticePoint} / glm::dvec2{_latticeSize};
+    auto evaluation = _surface.evaluate(
+        glm::mix(_minimumParameter, _maximumParameter, texCoords),
+        1
+    );
+
+    auto index = static_cast<int>(_samples.size());
+    _samples.push_back({
+        evaluation.position,
+        evaluation.getNormal(),
+        glm::vec2(texCoords)
+    });
+
+    _sampleIndices[key] = index;
+    return index;
+}
+
+}
+
+AdaptiveTessellationSettings::AdaptiveTessellationSettings():
+    initialResolution{4, 4},
+    maximumDepth{8},
+    chordHeightTolerance{0.001},
+    useScreenSpaceError{false},
+    eyePosition{},
+    projectionScale{1000.0},
+    screenSpaceTolerance{1.0}
+{
+}
+
+AdaptiveParametricSurfaceMeshBuilder::AdaptiveParametricSurfaceMeshBuilder()
+{
+}
+
+AdaptiveParametricSurfaceMeshBuilder::~AdaptiveParametricSurfaceMeshBuilder()
+{
+}
+
+const AdaptiveTessellationSettings &
+        AdaptiveParametricSurfaceMeshBuilder::getSettings() const
+{
+    return _settings;
+}
+
+void AdaptiveParametricSurfaceMeshBuilder::setSettings(
+    const AdaptiveTessellationSettings &settings
+)
+{
+    _settings = settings;
+}
+
+std::shared_ptr<Mesh<VertexNormalTexCoords>>
+        AdaptiveParametricSurfaceMeshBuilder::build(
+    std::shared_ptr<IParametricSurfaceUV> surface,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter
+) const
+{
+    std::vector<VertexNormalTexCoords> vertices;
+    std::vector<GLuint> indices;
+
+    buildGeometry(
+        *surface,
+        vertices,
+        indices,
+        minimumParameter,
+        maximumParameter
+    );
+
+    return std::make_shared<Mesh<VertexNormalTexCoords>>(vertices, indices);
+}
+
+void AdaptiveParametricSurfaceMeshBuilder::buildGeometry(
+    const IParametricSurfaceUV &surface,
+    std::vector<VertexNormalTexCoords> &vertices,
+    std::vector<GLuint> &indices,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter
+) const
+{
+    // cell indices are packed into 29 bits
+    assert(_settings.maximumDepth >= 0 && _settings.maximumDepth <= 16);
+    assert(glm::all(glm::lessThanEqual(
+        _settings.initialResolution,
+        glm::ivec2{4096, 4096}
+    )));
+
+    QuadtreeTessellation tessellation{
+        surface,
+        _settings,
+        minimumParameter,
+        maximumParameter
+    };
+
+    tessellation.refine();
+    tessellation.balance();
+    tessellation.triangulate(vertices, indices);
+}
+
+}
@@ -0,0 +1,154 @@
+#include "fw/numerical/BezierCurveSegment.hpp"
+
+#include <cassert>
+
+namespace fw
+{
+
+constexpr int BezierCurveSegment::MaxDegree;
+
+namespace
+{
+
+double getLocalParameter(double minimum, double maximum, double parameter)
+{
+    return maximum > minimum
+        ? (parameter - minimum) / (maximum - minimum)
+        : 0.0;
+}
+
+// Runs de Casteljau algorithm until two points are left, they span the
+// tangent of the segment at t and their blend is the point at t.
+void reduceToTangentPoints(
+    const std::vector<glm::dvec3> &controlPoints,
+    double t,
+    glm::dvec3 *points
+)
+{
+    auto numPoints = static_cast<int>(controlPoints.size());
+    for (auto i = 0; i < numPoints; ++i)
+    {
+        points[i] = controlPoints[i];
+    }
+
+    for (auto level = numPoints - 1; level > 1; --level)
+    {
+        for (auto i = 0; i < level; ++i)
+        {
+            points[i] = glm::mix(points[i], points[i + 1], t);
+        }
+    }
+}
+
+}
+
+BezierCurveSegment::BezierCurveSegment():
+    degree{0},
+    minimumParameter{},
+    maximumParameter{}
+{
+}
+
+BezierCurveSegment::~BezierCurveSegment()
+{
+}
+
+AABB<glm::dvec3> BezierCurveSegment::getBounds() const
+{
+    if (controlPoints.empty())
+    {
+        return {};
+    }
+
+    AABB<glm::dvec3> bounds{controlPoints.front(), controlPoints.front()};
+    for (const auto &point: controlPoints)
+    {
+        bounds.min = glm::min(bounds.min, point);
+        bounds.max = glm::max(bounds.max, point);
+    }
+
+    return bounds;
+}
+
+glm::dvec3 BezierCurveSegment::getPosition(double parameter) const
+{
+    assert(degree <= MaxDegree);
+
+    if (degree == 0)
+    {
+        return controlPoints.front();
+    }
+
+    glm::dvec3 points[MaxDegree + 1];
+    auto t = getLocalParameter(minimumParameter, maximumParameter, parameter);
+    reduceToTangentPoints(controlPoints, t, points);
+    return glm::mix(points[0], points[1], t);
+}
+
+glm::dvec3 BezierCurveSegment::getDerivative(double parameter) const
+{
+    assert(degree <= MaxDegree);
+
+    if (degree == 0 || !(maximumParameter > minimumParameter))
+    {
+        return {};
+    }
+
+    glm::dvec3 points[MaxDegree + 1];
+    auto t = getLocalParameter(minimumParameter, maximumParameter, parameter);
+    reduceToTangentPoints(controlPoints, t, points);
+    return static_cast<double>(degree) * (points[1] - points[0])
+        / (maximumParameter - minimumParameter);
+}
+
+void BezierCurveSegment::split(
+    double parameter,
+    BezierCurveSegment &lower,
+    BezierCurveSegment &upper
+) const
+{
+    auto t = getLocalParameter(minimumParameter, maximumParameter, parameter);
+    auto numPoints = degree + 1;
+
+    lower.degree = upper.degree = degree;
+    lower.minimumParameter = minimumParameter;
+    lower.maximumParameter = upper.minimumParameter = parameter;
+    upper.maximumParameter = maximumParameter;
+    lower.controlPoints.resize(numPoints);
+    upper.controlPoints.resize(numPoints);
+
+    // first points of every de Casteljau level define lower part, last
+    // points define upper part
+    auto points = controlPoints;
+    for (auto level = 0; level < numPoints; ++level)
+    {
+        lower.controlPoints[level] = points[0];
+        upper.controlPoints[degree - level] = points[degree - level];
+
+        for (auto i = 0; i < degree - level; ++i)
+        {
+            points[i] = glm::mix(points[i], points[i + 1], t);
+        }
+    }
+}
+
+std::vector<BezierCurveSegment> createPolylineSegments(
+    const std::vector<glm::dvec3> &points
+)
+{
+    auto numPoints = static_cast<int>(points.size());
+    std::vector<BezierCurveSegment> segments;
+    for (auto i = 0; i + 1 < numPoints; ++i)
+    {
+        BezierCurveSegment segment;
+        segment.degree = 1;
+        segment.minimumParameter = i;
+        segment.maximumParameter = i + 1;
+        segment.controlPoints = {points[i], points[i + 1]};
+        segments.push_back(segment);
+    }
+
+    return segments;
+}
+
+}
@@ -0,0 +1,165 @@
+#include "fw/numerical/BezierSurfacePatch.hpp"
+#include "fw/numerical/BezierCurveSegment.hpp"
+
+#include <cassert>
+
+namespace fw
+{
+
+constexpr int BezierSurfacePatch::MaxDegree;
+
+namespace
+{
+
+// All Bernstein polynomials of given degree at t (The NURBS Book A1.3).
+void evaluateBernsteinBasis(int degree, double t, double *basis)
+{
+    basis[0] = 1.0;
+    auto complement = 1.0 - t;
+
+    for (auto j = 1; j <= degree; ++j)
+    {
+        auto saved = 0.0;
+        for (auto k = 0; k < j; ++k)
+        {
+            auto temp = basis[k];
+            basis[k] = saved + complement * temp;
+            saved = t * temp;
+        }
+
+        basis[j] = saved;
+    }
+}
+
+double getLocalParameter(double minimum, double maximum, double parameter)
+{
+    return maximum > minimum
+        ? (parameter - minimum) / (maximum - minimum)
+        : 0.0;
+}
+
+}
+
+BezierSurfacePatch::BezierSurfacePatch():
+    degree{0},
+    minimumParameter{},
+    maximumParameter{}
+{
+}
+
+BezierSurfacePatch::~BezierSurfacePatch()
+{
+}
+
+AABB<glm::dvec3> BezierSurfacePatch::getBounds() const
+{
+    if (controlPoints.empty())
+    {
+        return {};
+    }
+
+    AABB<glm::dvec3> bounds{controlPoints.front(), controlPoints.front()};
+    for (const auto &point: controlPoints)
+    {
+        bounds.min = glm::min(bounds.min, point);
+        bounds.max = glm::max(bounds.max, point);
+    }
+
+    return bounds;
+}
+
+glm::dvec3 BezierSurfacePatch::getPosition(glm::dvec2 parametrisation) const
+{
+    assert(degree <= MaxDegree);
+
+    double basisU[MaxDegree + 1], basisV[MaxDegree + 1];
+    evaluateBernsteinBasis(
+        degree,
+        getLocalParameter(
+            minimumParameter.x,
+            maximumParameter.x,
+            parametrisation.x
+        ),
+        basisU
+    );
+
+    evaluateBernsteinBasis(
+        degree,
+        getLocalParameter(
+            minimumParameter.y,
+            maximumParameter.y,
+            parametrisation.y
+        ),
+        basisV
+    );
+
+    glm::dvec3 position{};
+    for (auto v = 0; v <= degree; ++v)
+    {
+        glm::dvec3 row{};
+        for (auto u = 0; u <= degree; ++u)
+        {
+            row += basisU[u] * controlPoints[v * (degree + 1) + u];
+        }
+
+        position += basisV[v] * row;
+    }
+
+    return position;
+}
+
+void BezierSurfacePatch::split(
+    ParametrizationAxis axis,
+    double parameter,
+    BezierSurfacePatch &lower,
+    BezierSurfacePatch &upper
+) const
+{
+    auto alongU = axis == ParametrizationAxis::U;
+    auto numPoints = degree + 1;
+    glm::ivec2 step = alongU ? glm::ivec2{1, 0} : glm::ivec2{0, 1};
+    glm::ivec2 lineStep = alongU ? glm::ivec2{0, 1} : glm::ivec2{1, 0};
+
+    lower.degree = upper.degree = degree;
+    lower.minimumParameter = upper.minimumParameter = minimumParameter;
+    lower.maximumParameter = upper.maximumParameter = maximumParameter;
+    lower.controlPoints.resize(controlPoints.size());
+    upper.controlPoints.resize(controlPoints.size());
+
+    BezierCurveSegment line, lowerLine, upperLine;
+    line.degree = degree;
+    line.minimumParameter = alongU ? minimumParameter.x : minimumParameter.y;
+    line.maximumParameter = alongU ? maximumParameter.x : maximumParameter.y;
+    line.controlPoints.resize(numPoints);
+
+    for (auto l = 0; l < numPoints; ++l)
+    {
+        for (auto i = 0; i < numPoints; ++i)
+        {
+            auto index = l * lineStep + i * step;
+            line.controlPoints[i] =
+                controlPoints[index.y * numPoints + index.x];
+        }
+
+        line.split(parameter, lowerLine, upperLine);
+
+        for (auto i = 0; i < numPoints; ++i)
+        {
+            auto index = l * lineStep + i * step;
+            auto pointIndex = index.y * numPoints + index.x;
+            lower.controlPoints[pointIndex] = lowerLine.controlPoints[i];
+            upper.controlPoints[pointIndex] = upperLine.controlPoints[i];
+        }
+    }
+
+    if (alongU)
+    {
+        lower.maximumParameter.x = upper.minimumParameter.x = parameter;
+    }
+    else
+    {
+        lower.maximumParameter.y = upper.minimumParameter.y = parameter;
+    }
+}
+
+}
@@ -1,17 +1,57 @@
 #include "fw/numerical/BsplineBasisEvaluator.hpp"
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <limits>
 #include <cmath>
 
 namespace fw
 {
 
+constexpr int BsplineBasisEvaluator::MaxLocalDegree;
+
+BsplineBasisEvaluator::KnotTables::KnotTables(
+    int maxDegree,
+    const std::vector<double> &knots
+):
+    maxDegree{maxDegree},
+    knots{knots},
+    reciprocals((maxDegree + 1) * knots.size(), 0.0)
+{
+    auto numKnots = static_cast<int>(knots.size());
+    for (auto degree = 1; degree <= maxDegree; ++degree)
+    {
+        for (auto i = 0; i + degree < numKnots; ++i)
+        {
+            auto difference = knots[i + degree] - knots[i];
+            if (std::abs(difference) > std::numeric_limits<double>::epsilon())
+            {
+                reciprocals[degree * knots.size() + i] = 1.0 / difference;
+            }
+        }
+    }
+}
+
 BsplineBasisEvaluator::BsplineBasisEvaluator(
     int degree,
     const std::vector<double> &knots
+):
+    BsplineBasisEvaluator{
+        degree,
+        std::make_shared<const KnotTables>(degree, knots)
+    }
+{
+}
+
+BsplineBasisEvaluator::BsplineBasisEvaluator(
+    int degree,
+    std::shared_ptr<const KnotTables> knotTables
 ):
     _degree{degree},
-    _knots{knots}
+    _knotTables{knotTables},
+    _knots{knotTables->knots}
 {
+    assert(_degree <= _knotTables->maxDegree);
 }
 
 BsplineBasisEvaluator::~BsplineBasisEvaluator()
@@ -35,6 +75,187 @@ std::vector<double> BsplineBasisEvaluator::evaluate(
     return basis;
 }
 
+int BsplineBasisEvaluator::getSupportSize() const
+{
+    return _degree + 1;
+}
+
+int BsplineBasisEvaluator::evaluateNonVanishing(
+    double parameter,
+    double *output
+) const
+{
+    std::fill(output, output + _degree + 1, 0.0);
+
+    auto span = findKnotSpan(parameter);
+    if (span < 0) { return -1; }
+
+    output[_degree] = 1.0;
+    for (auto targetDegree = 1; targetDegree <= _degree; ++targetDegree)
+    {
+        increaseLocalBasisDegree(output, span, targetDegree, parameter);
+    }
+
+    return span;
+}
+
+int BsplineBasisEvaluator::evaluateNonVanishingDerivatives(
+    double parameter,
+    int order,
+    double *output
+) const
+{
+    assert(_degree <= MaxLocalDegree);
+
+    auto supportSize = _degree + 1;
+    std::fill(output, output + (order + 1) * supportSize, 0.0);
+
+    // basis of every intermediate degree is kept, k-th derivative of
+    // degree p basis is built from degree p-k basis
+    std::array<double, (MaxLocalDegree + 1) * (MaxLocalDegree + 1)> levels;
+    auto span = evaluateNonVanishingAllDegrees(parameter, levels.data());
+    if (span < 0) { return -1; }
+
+    for (auto derivative = 0; derivative <= order; ++derivative)
+    {
+        auto derivativeOutput = output + derivative * supportSize;
+        auto baseDegree = _degree - derivative;
+        if (baseDegree < 0) { continue; }
+
+        std::copy(
+            levels.data() + baseDegree * supportSize,
+            levels.data() + (baseDegree + 1) * supportSize,
+            derivativeOutput
+        );
+
+        for (auto step = 1; step <= derivative; ++step)
+        {
+            differentiateLocalBasis(
+                derivativeOutput,
+                span,
+                baseDegree + step
+            );
+        }
+    }
+
+    return span;
+}
+
+int BsplineBasisEvaluator::evaluateNonVanishingAllDegrees(
+    double parameter,
+    double *output
+) const
+{
+    assert(_degree <= MaxLocalDegree);
+
+    auto supportSize = _degree + 1;
+    std::fill(output, output + supportSize * supportSize, 0.0);
+
+    auto span = findKnotSpan(parameter);
+    if (span < 0) { return -1; }
+
+    output[_degree] = 1.0;
+    for (auto targetDegree = 1; targetDegree <= _degree; ++targetDegree)
+    {
+        auto current = output + targetDegree * supportSize;
+        std::copy(current - supportSize, current, current);
+        increaseLocalBasisDegree(current, span, targetDegree, parameter);
+    }
+
+    return span;
+}
+
+int BsplineBasisEvaluator::getDegree() const
+{
+    return _degree;
+}
+
+const std::vector<double> &BsplineBasisEvaluator::getKnots() const
+{
+    return _knots;
+}
+
+std::shared_ptr<const BsplineBasisEvaluator::KnotTables>
+        BsplineBasisEvaluator::getKnotTables() const
+{
+    return _knotTables;
+}
+
+int BsplineBasisEvaluator::findKnotSpan(double parameter) const
+{
+    if (_knots.size() < 2
+        || parameter < _knots.front()
+        || !(parameter < _knots.back()))
+    {
+        return -1;
+    }
+
+    auto upper = std::upper_bound(
+        std::begin(_knots),
+        std::end(_knots),
+        parameter
+    );
+
+    return static_cast<int>(std::distance(std::begin(_knots), upper)) - 1;
+}
+
+void BsplineBasisEvaluator::increaseLocalBasisDegree(
+    double *basis,
+    int span,
+    int targetDegree,
+    double parameter
+) const
+{
+    // basis[k] holds N(span - degree + k) of currently processed degree,
+    // the same recurrence as increaseBasisDegree restricted to the span
+    auto lastKnot = static_cast<int>(_knots.size()) - 1;
+    for (auto k = _degree - targetDegree; k <= _degree; ++k)
+    {
+        auto i = span - _degree + k;
+        if (i < 0 || i + targetDegree + 1 > lastKnot)
+        {
+            basis[k] = 0.0;
+            continue;
+        }
+
+        auto leftCoefficient = (parameter - _knots[i])
+            * _knotTables->getReciprocal(targetDegree, i);
+        auto rightCoefficient = (_knots[i + targetDegree + 1] - parameter)
+            * _knotTables->getReciprocal(targetDegree, i + 1);
+
+        auto nextBasis = k < _degree ? basis[k + 1] : 0.0;
+        basis[k] = leftCoefficient * basis[k] + rightCoefficient * nextBasis;
+    }
+}
+
+void BsplineBasisEvaluator::differentiateLocalBasis(
+    double *basis,
+    int span,
+    int targetDegree
+) const
+{
+    // N'(i, p) = p * (N(i, p-1) / (t(i+p) - t(i))
+    //     - N(i+1, p-1) / (t(i+p+1) - t(i+1)))
+    auto lastKnot = static_cast<int>(_knots.size()) - 1;
+    for (auto k = 0; k <= _degree; ++k)
+    {
+        auto i = span - _degree + k;
+        if (i < 0 || i + targetDegree + 1 > lastKnot)
+        {
+            basis[k] = 0.0;
+            continue;
+        }
+
+        auto leftCoefficient =
+            targetDegree * _knotTables->getReciprocal(targetDegree, i);
+        auto rightCoefficient =
+            targetDegree * _knotTables->getReciprocal(targetDegree, i + 1);
+
+        auto nextBasis = k < _degree ? basis[k + 1] : 0.0;
+        basis[k] = leftCoefficient * basis[k] - rightCoefficient * nextBasis;
+    }
+}
+
 std::vector<double> BsplineBasisEvaluator::evaluateZeroDegreeBasis(
     double parameter
 ) const
@@ -61,21 +282,10 @@ void BsplineBasisEvaluator::increaseBasisDegree(
     auto targetDegree = currentDegreeOfBasis + 1;
     for (auto i = 0; i < _knots.size() - targetDegree - 1; ++i)
     {
-        auto leftNumerator = parameter - _knots[i];
-        auto leftDenominator = _knots[i + targetDegree] - _knots[i];
-
-        auto rightNumerator = _knots[i + targetDegree + 1] - parameter;
-        auto rightDenominator = _knots[i + targetDegree + 1] - _knots[i + 1];
-
-        auto leftCoefficient =
-            std::abs(leftDenominator) > std::numeric_limits<double>::epsilon()
-            ? leftNumerator / leftDenominator
-            : 0.0;
-
-        auto rightCoefficient =
-            std::abs(rightDenominator) > std::numeric_limits<double>::epsilon()
-            ? rightNumerator / rightDenominator
-            : 0.0;
+        auto leftCoefficient = (parameter - _knots[i])
+            * _knotTables->getReciprocal(targetDegree, i);
+        auto rightCoefficient = (_knots[i + targetDegree + 1] - parameter)
+            * _knotTables->getReciprocal(targetDegree, i + 1);
 
         auto currentIntervalValue = leftCoefficient * basis[i]
             + rightCoefficient * basis[i + 1];
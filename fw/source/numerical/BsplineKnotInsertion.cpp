@@ -0,0 +1,295 @@
+#include "fw/numerical/BsplineKnotInsertion.hpp"
+
+namespace fw
+{
+
+namespace
+{
+
+// Control net of surface with knot vectors, refined one axis at a time.
+struct ControlNet
+{
+public:
+    int degree;
+    glm::ivec2 size;
+    std::vector<glm::dvec3> points;
+    std::vector<double> knotsU;
+    std::vector<double> knotsV;
+};
+
+ControlNet getUnfoldedControlNet(const BsplineSurface &surface)
+{
+    ControlNet net;
+    net.degree = surface.getDegree();
+    net.size = surface.getFoldedGridSize();
+    net.knotsU = surface.getKnotsOnU();
+    net.knotsV = surface.getKnotsOnV();
+    net.points.resize(net.size.x * net.size.y);
+
+    for (auto v = 0; v < net.size.y; ++v)
+    {
+        for (auto u = 0; u < net.size.x; ++u)
+        {
+            net.points[v * net.size.x + u] =
+                surface.getFoldedControlPoint(u, v);
+        }
+    }
+
+    return net;
+}
+
+std::shared_ptr<BsplineSurface> createSurface(const ControlNet &net)
+{
+    return std::make_shared<BsplineSurface>(
+        net.degree,
+        net.size,
+        net.points,
+        net.knotsU,
+        net.knotsV
+    );
+}
+
+// Refines every row (axis U) or column (axis V) of the net by inserting
+// knot until it has given multiplicity.
+void refineKnot(
+    ControlNet &net,
+    ParametrizationAxis axis,
+    double knot,
+    int multiplicity
+)
+{
+    auto alongU = axis == ParametrizationAxis::U;
+    auto &knots = alongU ? net.knotsU : net.knotsV;
+    glm::ivec2 step = alongU ? glm::ivec2{1, 0} : glm::ivec2{0, 1};
+    glm::ivec2 lineStep = alongU ? glm::ivec2{0, 1} : glm::ivec2{1, 0};
+    auto numLines = alongU ? net.size.y : net.size.x;
+
+    while (getKnotMultiplicity(knots, knot) < multiplicity)
+    {
+        auto lineLength = alongU ? net.size.x : net.size.y;
+        auto refinedSize = net.size + step;
+        std::vector<glm::dvec3> refinedPoints(refinedSize.x * refinedSize.y);
+        std::vector<glm::dvec3> line(lineLength);
+        auto inserted = false;
+
+        for (auto l = 0; l < numLines; ++l)
+        {
+            auto start = l * lineStep;
+            line.resize(lineLength);
+            for (auto i = 0; i < lineLength; ++i)
+            {
+                auto index = start + i * step;
+                line[i] = net.points[index.y * net.size.x + index.x];
+            }
+
+            inserted = insertKnotIntoControlPolygon(
+                net.degree,
+                knots,
+                knot,
+                line
+            );
+
+            if (!inserted) { break; }
+
+            for (auto i = 0; i <= lineLength; ++i)
+            {
+                auto index = start + i * step;
+                refinedPoints[index.y * refinedSize.x + index.x] = line[i];
+            }
+        }
+
+        if (!inserted) { return; }
+
+        knots.insert(
+            std::upper_bound(std::begin(knots), std::end(knots), knot),
+            knot
+        );
+
+        net.size = refinedSize;
+        net.points.swap(refinedPoints);
+    }
+}
+
+std::vector<double> getDistinctDomainKnots(
+    const std::vector<double> &knots,
+    int degree,
+    int numPoints
+)
+{
+    std::vector<double> domainKnots(
+        std::begin(knots) + degree,
+        std::begin(knots) + numPoints + 1
+    );
+
+    domainKnots.erase(
+        std::unique(std::begin(domainKnots), std::end(domainKnots)),
+        std::end(domainKnots)
+    );
+
+    return domainKnots;
+}
+
+}
+
+std::vector<BezierCurveSegment> decomposeIntoBezierCurveSegments(
+    const BsplineCurve3d &curve
+)
+{
+    auto controlPolygons = decomposeIntoBezierSegments(curve);
+    auto knots = getDistinctDomainKnots(
+        curve.getKnots(),
+        curve.getDegree(),
+        static_cast<int>(curve.getControlPoints().size())
+    );
+
+    assert(knots.size() == controlPolygons.size() + 1);
+
+    auto numSegments = static_cast<int>(controlPolygons.size());
+    std::vector<BezierCurveSegment> segments(numSegments);
+    for (auto i = 0; i < numSegments; ++i)
+    {
+        segments[i].degree = curve.getDegree();
+        segments[i].minimumParameter = knots[i];
+        segments[i].maximumParameter = knots[i + 1];
+        segments[i].controlPoints.swap(controlPolygons[i]);
+    }
+
+    return segments;
+}
+
+std::shared_ptr<BsplineSurface> insertKnot(
+    const BsplineSurface &surface,
+    ParametrizationAxis axis,
+    double knot,
+    int times
+)
+{
+    auto net = getUnfoldedControlNet(surface);
+    const auto &knots = axis == ParametrizationAxis::U
+        ? net.knotsU
+        : net.knotsV;
+
+    refineKnot(net, axis, knot, getKnotMultiplicity(knots, knot) + times);
+    return createSurface(net);
+}
+
+std::vector<BezierSurfacePatch> decomposeIntoBezierPatches(
+    const BsplineSurface &surface
+)
+{
+    auto net = getUnfoldedControlNet(surface);
+    auto degree = net.degree;
+
+    auto knotsU = getDistinctDomainKnots(net.knotsU, degree, net.size.x);
+    for (auto knot: knotsU)
+    {
+        refineKnot(net, ParametrizationAxis::U, knot, degree);
+    }
+
+    auto knotsV = getDistinctDomainKnots(net.knotsV, degree, net.size.y);
+    for (auto knot: knotsV)
+    {
+        refineKnot(net, ParametrizationAxis::V, knot, degree);
+    }
+
+    // spans bounded by knots of multiplicity degree have their Bezier
+    // points as (degree + 1) x (degree + 1) control points
+    std::vector<BezierSurfacePatch> patches;
+    for (auto spanV = degree; spanV < net.size.y; ++spanV)
+    {
+        if (!(net.knotsV[spanV] < net.knotsV[spanV + 1])) { continue; }
+
+        for (auto spanU = degree; spanU < net.size.x; ++spanU)
+        {
+            if (!(net.knotsU[spanU] < net.knotsU[spanU + 1])) { continue; }
+
+            BezierSurfacePatch patch;
+            patch.degree = degree;
+            patch.minimumParameter = {net.knotsU[spanU], net.knotsV[spanV]};
+            patch.maximumParameter = {
+                net.knotsU[spanU + 1],
+                net.knotsV[spanV + 1]
+            };
+
+            patch.controlPoints.reserve((degree + 1) * (degree + 1));
+            for (auto v = spanV - degree; v <= spanV; ++v)
+            {
+                for (auto u = spanU - degree; u <= spanU; ++u)
+                {
+                    patch.controlPoints.push_back(
+                        net.points[v * net.size.x + u]
+                    );
+                }
+            }
+
+            patches.push_back(patch);
+        }
+    }
+
+    return patches;
+}
+
+std::shared_ptr<BsplineSurface> extractPatch(
+    const BsplineSurface &surface,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter
+)
+{
+    assert(glm::all(glm::lessThan(minimumParameter, maximumParameter)));
+
+    auto net = getUnfoldedControlNet(surface);
+    auto degree = net.degree;
+
+    refineKnot(net, ParametrizationAxis::U, minimumParameter.x, degree);
+    refineKnot(net, ParametrizationAxis::U, maximumParameter.x, degree);
+    refineKnot(net, ParametrizationAxis::V, minimumParameter.y, degree);
+    refineKnot(net, ParametrizationAxis::V, maximumParameter.y, degree);
+
+    auto spansU = internal::getSegmentSpans(
+        net.knotsU,
+        minimumParameter.x,
+        maximumParameter.x
+    );
+
+    auto spansV = internal::getSegmentSpans(
+        net.knotsV,
+        minimumParameter.y,
+        maximumParameter.y
+    );
+
+    ControlNet patch;
+    patch.degree = degree;
+    patch.size = {
+        spansU.y - spansU.x + degree + 1,
+        spansV.y - spansV.x + degree + 1
+    };
+
+    patch.points.reserve(patch.size.x * patch.size.y);
+    for (auto v = spansV.x - degree; v <= spansV.y; ++v)
+    {
+        for (auto u = spansU.x - degree; u <= spansU.y; ++u)
+        {
+            patch.points.push_back(net.points[v * net.size.x + u]);
+        }
+    }
+
+    // outermost knots do not affect the patch, they only clamp it
+    patch.knotsU.assign(
+        std::begin(net.knotsU) + spansU.x - degree,
+        std::begin(net.knotsU) + spansU.y + degree + 2
+    );
+
+    patch.knotsV.assign(
+        std::begin(net.knotsV) + spansV.x - degree,
+        std::begin(net.knotsV) + spansV.y + degree + 2
+    );
+
+    patch.knotsU.front() = minimumParameter.x;
+    patch.knotsU.back() = maximumParameter.x;
+    patch.knotsV.front() = minimumParameter.y;
+    patch.knotsV.back() = maximumParameter.y;
+
+    return createSurface(patch);
+}
+
+}
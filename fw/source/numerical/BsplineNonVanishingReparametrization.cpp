@@ -9,6 +9,17 @@ BsplineNonVanishingReparametrization::BsplineNonVanishingReparametrization(
 ):
     _bsplineSurface{bsplineSurface}
 {
+    // knots of the surface are fixed, so parameter maps are affine maps
+    // from unit square onto its domain, known up front
+    const auto &knotsU = _bsplineSurface->getKnotsOnU();
+    const auto &knotsV = _bsplineSurface->getKnotsOnV();
+    auto degree = _bsplineSurface->getDegree();
+
+    _parameterOrigin = {knotsU[degree], knotsV[degree]};
+    _parameterScale = glm::dvec2{
+        knotsU[knotsU.size() - degree - 1],
+        knotsV[knotsV.size() - degree - 1]
+    } - _parameterOrigin;
 }
 
 BsplineNonVanishingReparametrization::~BsplineNonVanishingReparametrization()
@@ -21,14 +32,10 @@ std::shared_ptr<ICurve3d>
     double parameter
 ) const
 {
-    auto surfaceReparametrization =
-        calculateReparametrization({parameter, parameter});
-
+    auto axis = constParameter == ParametrizationAxis::U ? 0 : 1;
     auto bsplineCurve = _bsplineSurface->getConstParameterCurve(
         constParameter,
-        constParameter == ParametrizationAxis::U
-            ? surfaceReparametrization.x
-            : surfaceReparametrization.y
+        _parameterOrigin[axis] + parameter * _parameterScale[axis]
     );
 
     return std::make_shared<BsplineNonVanishingCurveReparametrization3d>(
@@ -36,75 +43,143 @@ std::shared_ptr<ICurve3d>
     );
 }
 
+bool BsplineNonVanishingReparametrization::isPeriodic(
+    ParametrizationAxis axis
+) const
+{
+    return _bsplineSurface->isPeriodic(axis);
+}
+
 glm::dvec3 BsplineNonVanishingReparametrization::getPosition(
     glm::dvec2 parametrization
 ) const
 {
-    return getConstParameterCurve(ParametrizationAxis::U, parametrization.x)
-        ->evaluate(parametrization.y);
+    return evaluate(parametrization, 0).position;
 }
 
 glm::dvec3 BsplineNonVanishingReparametrization::getNormal(
     glm::dvec2 parametrisation
 ) const
 {
-    auto du = getDerivativeU(parametrisation);
-    auto dv = getDerivativeV(parametrisation);
-    return glm::normalize(glm::cross(dv, du));
+    return evaluate(parametrisation, 1).getNormal();
 }
 
 glm::dvec3 BsplineNonVanishingReparametrization::getDerivativeU(
     glm::dvec2 parametrisation
 ) const
 {
-    auto derivFactors = calculateReparametrizationDerivativeFactors();
-    return derivFactors.y *
-        getConstParameterCurve(ParametrizationAxis::V, parametrisation.y)
-            ->getDerivativeCurve()->evaluate(parametrisation.x);
+    return evaluate(parametrisation, 1).derivativeU;
 }
 
 glm::dvec3 BsplineNonVanishingReparametrization::getDerivativeV(
     glm::dvec2 parametrisation
 ) const
 {
-    auto derivFactors = calculateReparametrizationDerivativeFactors();
-    return derivFactors.x *
-        getConstParameterCurve(ParametrizationAxis::U, parametrisation.x)
-            ->getDerivativeCurve()->evaluate(parametrisation.y);
+    return evaluate(parametrisation, 1).derivativeV;
 }
 
-glm::dvec2 BsplineNonVanishingReparametrization::
-        calculateReparametrizationDerivativeFactors() const
+SurfaceEvaluation BsplineNonVanishingReparametrization::evaluate(
+    glm::dvec2 parametrisation,
+    int order
+) const
 {
-    auto knotsX = _bsplineSurface->getKnotsOnU();
-    auto knotsY = _bsplineSurface->getKnotsOnV();
-    auto degree = _bsplineSurface->getDegree();
-    auto duFactor = knotsX[knotsX.size() - degree - 1] - knotsX[degree];
-    auto dvFactor = knotsY[knotsY.size() - degree - 1] - knotsY[degree];
-    return {duFactor, dvFactor};
+    auto evaluation = _bsplineSurface->evaluate(
+        calculateReparametrization(parametrisation),
+        order
+    );
+
+    // chain rule for affine parameter maps
+    if (evaluation.order >= 1)
+    {
+        evaluation.derivativeU *= _parameterScale.x;
+        evaluation.derivativeV *= _parameterScale.y;
+    }
+
+    if (evaluation.order >= 2)
+    {
+        evaluation.derivativeUU *= _parameterScale.x * _parameterScale.x;
+        evaluation.derivativeUV *= _parameterScale.x * _parameterScale.y;
+        evaluation.derivativeVV *= _parameterScale.y * _parameterScale.y;
+    }
+
+    return evaluation;
 }
 
-glm::dvec2 BsplineNonVanishingReparametrization::calculateReparametrization(
-    glm::dvec2 parametrization
+void BsplineNonVanishingReparametrization::sampleGridRows(
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter,
+    glm::ivec2 resolution,
+    int firstRow,
+    int numRows,
+    glm::dvec3 *positions,
+    glm::dvec3 *normals
 ) const
 {
-    auto knotsX = _bsplineSurface->getKnotsOnU();
-    auto knotsY = _bsplineSurface->getKnotsOnV();
-    auto degree = _bsplineSurface->getDegree();
-
-    auto newU = glm::mix(
-        knotsX[degree],
-        knotsX[knotsX.size() - degree - 1],
-        parametrization.x
+    // parameter maps are affine with positive factors - regular grid maps
+    // to regular grid and normals stay the same
+    _bsplineSurface->sampleGridRows(
+        calculateReparametrization(minimumParameter),
+        calculateReparametrization(maximumParameter),
+        resolution,
+        firstRow,
+        numRows,
+        positions,
+        normals
     );
+}
 
-    auto newV = glm::mix(
-        knotsY[degree],
-        knotsY[knotsY.size() - degree - 1],
-        parametrization.y
+void BsplineNonVanishingReparametrization::sampleGridRowsSinglePrecision(
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter,
+    glm::ivec2 resolution,
+    int firstRow,
+    int numRows,
+    glm::vec3 *positions,
+    glm::vec3 *normals
+) const
+{
+    _bsplineSurface->sampleGridRowsSinglePrecision(
+        calculateReparametrization(minimumParameter),
+        calculateReparametrization(maximumParameter),
+        resolution,
+        firstRow,
+        numRows,
+        positions,
+        normals
     );
+}
 
-    return glm::vec2 { newU, newV };
+std::vector<AABB<glm::dvec2>>
+        BsplineNonVanishingReparametrization::getControlPointSupport(
+    int u,
+    int v
+) const
+{
+    const AABB<glm::dvec2> unitSquare{{0.0, 0.0}, {1.0, 1.0}};
+
+    std::vector<AABB<glm::dvec2>> regions;
+    for (const auto &support: _bsplineSurface->getControlPointSupport(u, v))
+    {
+        AABB<glm::dvec2> region{
+            (support.min - _parameterOrigin) / _parameterScale,
+            (support.max - _parameterOrigin) / _parameterScale
+        };
+
+        region = region.intersect(unitSquare);
+        if (region.isValid())
+        {
+            regions.push_back(region);
+        }
+    }
+
+    return regions;
+}
+
+glm::dvec2 BsplineNonVanishingReparametrization::calculateReparametrization(
+    glm::dvec2 parametrization
+) const
+{
+    return _parameterOrigin + parametrization * _parameterScale;
 }
 
 }
@@ -2,11 +2,33 @@
 #include "fw/numerical/BsplineEquidistantKnotGenerator.hpp"
 #include "fw/numerical/BsplineBasisEvaluator.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cassert>
 #include <iostream>
 
 namespace fw
 {
 
+constexpr int BsplineSurface::MaxDerivativeOrder;
+
+namespace
+{
+
+double getGridSampleParameter(
+    double minimumParameter,
+    double maximumParameter,
+    int sample,
+    int resolution
+)
+{
+    if (resolution <= 1) { return minimumParameter; }
+    auto t = static_cast<double>(sample) / (resolution - 1);
+    return glm::mix(minimumParameter, maximumParameter, t);
+}
+
+}
+
 BsplineSurface::BsplineSurface(
     int surfaceDegree,
     glm::ivec2 controlPointsGridSize,
@@ -22,8 +44,13 @@ BsplineSurface::BsplineSurface(
     _knotsU{knotsU},
     _knotsV{knotsV},
     _foldingMode{foldingMode},
-    _foldDepth{foldDepth}
+    _foldDepth{foldDepth},
+    _basisEvaluatorU{surfaceDegree, knotsU},
+    _basisEvaluatorV{surfaceDegree, knotsV}
 {
+    assert(_degree <= BsplineBasisEvaluator::MaxLocalDegree);
+    createDerivativeNets();
+    createSinglePrecisionSampler();
 }
 
 BsplineSurface::~BsplineSurface()
@@ -57,8 +84,8 @@ std::shared_ptr<ICurve3d> BsplineSurface::getConstParameterCurve(
             _degree,
             subcontrol,
             constParameter == ParametrizationAxis::U
-                ? _knotsU
-                : _knotsV
+                ? _basisEvaluatorU
+                : _basisEvaluatorV
         };
 
         subcurveControlPoints.push_back(
@@ -66,42 +93,192 @@ std::shared_ptr<ICurve3d> BsplineSurface::getConstParameterCurve(
         );
     }
 
-    const auto &secondKnotVector = constParameter == ParametrizationAxis::U
-        ? _knotsV
-        : _knotsU;
+    const auto &secondBasisEvaluator = constParameter == ParametrizationAxis::U
+        ? _basisEvaluatorV
+        : _basisEvaluatorU;
 
     return std::static_pointer_cast<ICurve3d>(
         std::make_shared<BsplineCurve3d>(
             _degree,
             subcurveControlPoints,
-            secondKnotVector
+            secondBasisEvaluator
         )
     );
 }
 
 glm::dvec3 BsplineSurface::getPosition(glm::dvec2 parametrization) const
 {
-    return getConstParameterCurve(ParametrizationAxis::U, parametrization.x)
-        ->evaluate(parametrization.y);
+    return evaluate(parametrization, 0).position;
 }
 
 glm::dvec3 BsplineSurface::getNormal(glm::dvec2 parametrisation) const
 {
-    auto du = getDerivativeU(parametrisation);
-    auto dv = getDerivativeV(parametrisation);
-    return glm::normalize(glm::cross(dv, du));
+    return evaluate(parametrisation, 1).getNormal();
 }
 
 glm::dvec3 BsplineSurface::getDerivativeU(glm::dvec2 parametrisation) const
 {
-    return getConstParameterCurve(ParametrizationAxis::V, parametrisation.y)
-        ->getDerivativeCurve()->evaluate(parametrisation.x);
+    return evaluate(parametrisation, 1).derivativeU;
 }
 
 glm::dvec3 BsplineSurface::getDerivativeV(glm::dvec2 parametrisation) const
 {
-    return getConstParameterCurve(ParametrizationAxis::U, parametrisation.x)
-        ->getDerivativeCurve()->evaluate(parametrisation.y);
+    return evaluate(parametrisation, 1).derivativeV;
+}
+
+SurfaceEvaluation BsplineSurface::evaluate(
+    glm::dvec2 parametrisation,
+    int order
+) const
+{
+    order = std::max(0, std::min(order, MaxDerivativeOrder));
+
+    const auto rowSize = BsplineBasisEvaluator::MaxLocalDegree + 1;
+    std::array<double, rowSize * rowSize> basisU, basisV;
+
+    auto spanU = _basisEvaluatorU.evaluateNonVanishingAllDegrees(
+        parametrisation.x,
+        basisU.data()
+    );
+
+    auto spanV = _basisEvaluatorV.evaluateNonVanishingAllDegrees(
+        parametrisation.y,
+        basisV.data()
+    );
+
+    SurfaceEvaluation evaluation;
+    evaluation.order = order;
+    evaluateTensorProduct(
+        order,
+        spanU,
+        basisU.data(),
+        spanV,
+        basisV.data(),
+        evaluation
+    );
+
+    return evaluation;
+}
+
+void BsplineSurface::sampleGridRows(
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter,
+    glm::ivec2 resolution,
+    int firstRow,
+    int numRows,
+    glm::dvec3 *positions,
+    glm::dvec3 *normals
+) const
+{
+    auto order = normals != nullptr ? 1 : 0;
+    auto supportSize = _degree + 1;
+    auto basisSize = (order + 1) * supportSize;
+
+    // basis functions are shared by whole rows and columns of samples,
+    // so they are evaluated once per sampled parameter
+    std::vector<int> spansU(resolution.x), spansV(numRows);
+    std::vector<double> basisU(resolution.x * basisSize);
+    std::vector<double> basisV(numRows * basisSize);
+
+    for (auto x = 0; x < resolution.x; ++x)
+    {
+        spansU[x] = _basisEvaluatorU.evaluateNonVanishingDerivatives(
+            getGridSampleParameter(
+                minimumParameter.x,
+                maximumParameter.x,
+                x,
+                resolution.x
+            ),
+            order,
+            basisU.data() + x * basisSize
+        );
+    }
+
+    for (auto y = 0; y < numRows; ++y)
+    {
+        spansV[y] = _basisEvaluatorV.evaluateNonVanishingDerivatives(
+            getGridSampleParameter(
+                minimumParameter.y,
+                maximumParameter.y,
+                firstRow + y,
+                resolution.y
+            ),
+            order,
+            basisV.data() + y * basisSize
+        );
+    }
+
+    // for every row of samples the control net is first collapsed on V
+    // (value and derivative), then each sample needs only degree+1 points
+    auto foldedGridSize = getFoldedGridSize();
+    std::vector<glm::dvec3> collapsedRows((order + 1) * foldedGridSize.x);
+    auto collapsedValue = collapsedRows.data();
+    auto collapsedDerivative = collapsedRows.data() + foldedGridSize.x;
+
+    for (auto y = 0; y < numRows; ++y)
+    {
+        std::fill(std::begin(collapsedRows), std::end(collapsedRows),
+            glm::dvec3{});
+
+        auto spanV = spansV[y];
+        auto rowBasis = basisV.data() + y * basisSize;
+        auto firstV = spanV - _degree;
+
+        for (auto j = std::max(0, -firstV); spanV >= 0 && j <= _degree; ++j)
+        {
+            auto v = firstV + j;
+            if (v >= foldedGridSize.y) { break; }
+
+            for (auto k = 0; k <= order; ++k)
+            {
+                auto weight = rowBasis[k * supportSize + j];
+                auto collapsed = collapsedRows.data() + k * foldedGridSize.x;
+                for (auto u = 0; u < foldedGridSize.x; ++u)
+                {
+                    collapsed[u] += weight * getFoldedControlPoint(u, v);
+                }
+            }
+        }
+
+        for (auto x = 0; x < resolution.x; ++x)
+        {
+            auto spanU = spansU[x];
+            auto columnBasis = basisU.data() + x * basisSize;
+            auto firstU = spanU - _degree;
+
+            glm::dvec3 position{}, derivativeU{}, derivativeV{};
+            for (auto i = std::max(0, -firstU);
+                spanU >= 0 && spanV >= 0 && i <= _degree; ++i)
+            {
+                auto u = firstU + i;
+                if (u >= foldedGridSize.x) { break; }
+
+                position += columnBasis[i] * collapsedValue[u];
+                if (order > 0)
+                {
+                    derivativeU += columnBasis[supportSize + i]
+                        * collapsedValue[u];
+                    derivativeV += columnBasis[i] * collapsedDerivative[u];
+                }
+            }
+
+            auto sampleIndex = y * resolution.x + x;
+            positions[sampleIndex] = position;
+            if (normals != nullptr)
+            {
+                normals[sampleIndex] = glm::normalize(
+                    glm::cross(derivativeV, derivativeU)
+                );
+            }
+        }
+    }
+}
+
+bool BsplineSurface::isPeriodic(ParametrizationAxis axis) const
+{
+    return axis == ParametrizationAxis::U
+        ? _foldingMode == SurfaceFoldingMode::ContinuousU
+        : _foldingMode == SurfaceFoldingMode::ContinuousV;
 }
 
 int BsplineSurface::getDegree() const
@@ -109,6 +286,11 @@ int BsplineSurface::getDegree() const
     return _degree;
 }
 
+SurfaceFoldingMode BsplineSurface::getFoldingMode() const
+{
+    return _foldingMode;
+}
+
 const std::vector<glm::dvec3> &BsplineSurface::getControlPoints() const
 {
     return _controlPoints;
@@ -168,5 +350,256 @@ std::vector<glm::dvec3> BsplineSurface::evaluateConstParamControlPoints(
     return subcontrolPoints;
 }
 
+void BsplineSurface::sampleGridRowsSinglePrecision(
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter,
+    glm::ivec2 resolution,
+    int firstRow,
+    int numRows,
+    glm::vec3 *positions,
+    glm::vec3 *normals
+) const
+{
+    _singlePrecisionSampler->sampleGridRows(
+        minimumParameter,
+        maximumParameter,
+        resolution,
+        firstRow,
+        numRows,
+        positions,
+        normals
+    );
+}
+
+glm::ivec2 BsplineSurface::getFoldedGridSize() const
+{
+    return {
+        _controlPointsGridSize.x +
+            (_foldingMode == SurfaceFoldingMode::ContinuousU ? _foldDepth : 0),
+        _controlPointsGridSize.y +
+            (_foldingMode == SurfaceFoldingMode::ContinuousV ? _foldDepth : 0)
+    };
+}
+
+const glm::dvec3 &BsplineSurface::getFoldedControlPoint(int u, int v) const
+{
+    auto x = u % _controlPointsGridSize.x;
+    auto y = v % _controlPointsGridSize.y;
+    return _controlPoints[_controlPointsGridSize.x * y + x];
+}
+
+void BsplineSurface::setControlPoint(
+    int u,
+    int v,
+    const glm::dvec3 &point
+)
+{
+    _controlPoints[_controlPointsGridSize.x * v + u] = point;
+
+    // cached nets are linear in the grid size, that is negligible next to
+    // re-tessellation of the changed region
+    createDerivativeNets();
+    createSinglePrecisionSampler();
+}
+
+std::vector<AABB<glm::dvec2>> BsplineSurface::getControlPointSupport(
+    int u,
+    int v
+) const
+{
+    // folded point i is weight of basis function N(i), which is non-zero
+    // only over [t(i), t(i + degree + 1))
+    auto foldedGridSize = getFoldedGridSize();
+    auto lastKnotU = static_cast<int>(_knotsU.size()) - 1;
+    auto lastKnotV = static_cast<int>(_knotsV.size()) - 1;
+
+    std::vector<AABB<glm::dvec2>> regions;
+    for (auto foldedV = v;
+        foldedV < foldedGridSize.y;
+        foldedV += _controlPointsGridSize.y)
+    {
+        for (auto foldedU = u;
+            foldedU < foldedGridSize.x;
+            foldedU += _controlPointsGridSize.x)
+        {
+            regions.push_back({
+                {
+                    _knotsU[std::min(foldedU, lastKnotU)],
+                    _knotsV[std::min(foldedV, lastKnotV)]
+                },
+                {
+                    _knotsU[std::min(foldedU + _degree + 1, lastKnotU)],
+                    _knotsV[std::min(foldedV + _degree + 1, lastKnotV)]
+                }
+            });
+        }
+    }
+
+    return regions;
+}
+
+void BsplineSurface::createDerivativeNets()
+{
+    auto foldedGridSize = getFoldedGridSize();
+
+    auto &controlNet = _derivativeNets[0][0];
+    controlNet.size = foldedGridSize;
+    controlNet.points.resize(foldedGridSize.x * foldedGridSize.y);
+
+    for (auto v = 0; v < foldedGridSize.y; ++v)
+    {
+        for (auto u = 0; u < foldedGridSize.x; ++u)
+        {
+            controlNet.points[v * foldedGridSize.x + u] =
+                getFoldedControlPoint(u, v);
+        }
+    }
+
+    for (auto k = 0; k <= MaxDerivativeOrder; ++k)
+    {
+        for (auto l = 0; k + l <= MaxDerivativeOrder; ++l)
+        {
+            if (k == 0 && l == 0) { continue; }
+
+            _derivativeNets[k][l] = k > 0
+                ? differentiateNet(
+                    _derivativeNets[k - 1][l],
+                    ParametrizationAxis::U,
+                    k - 1
+                )
+                : differentiateNet(
+                    _derivativeNets[k][l - 1],
+                    ParametrizationAxis::V,
+                    l - 1
+                );
+        }
+    }
+}
+
+void BsplineSurface::createSinglePrecisionSampler()
+{
+    _singlePrecisionSampler = std::make_shared<BsplineSurfaceSampler3f>(
+        _degree,
+        _derivativeNets[0][0].size,
+        _derivativeNets[0][0].points,
+        _knotsU,
+        _knotsV
+    );
+}
+
+BsplineSurface::DerivativeNet BsplineSurface::differentiateNet(
+    const DerivativeNet &net,
+    ParametrizationAxis axis,
+    int netDerivativeOrder
+) const
+{
+    // derivative of sum N(s, q) R(s) is sum N(s, q-1) Q(s) with
+    // Q(s) = q / (t(s+q) - t(s)) * (R(s) - R(s-1)), R outside net being
+    // zero. Boundary points keep derivatives exact over vanishing regions
+    // of unclamped knot vectors.
+    auto alongU = axis == ParametrizationAxis::U;
+    const auto &knotTables = alongU
+        ? *_basisEvaluatorU.getKnotTables()
+        : *_basisEvaluatorV.getKnotTables();
+
+    auto netDegree = _degree - netDerivativeOrder;
+    glm::ivec2 step = alongU ? glm::ivec2{1, 0} : glm::ivec2{0, 1};
+
+    DerivativeNet derivative;
+    derivative.size = net.size + step;
+    derivative.points.resize(derivative.size.x * derivative.size.y);
+
+    if (netDegree <= 0) { return derivative; }
+
+    for (auto v = 0; v < derivative.size.y; ++v)
+    {
+        for (auto u = 0; u < derivative.size.x; ++u)
+        {
+            auto previous = glm::ivec2{u, v} - step;
+            auto current = glm::dvec3{};
+            auto before = glm::dvec3{};
+
+            if (u < net.size.x && v < net.size.y)
+            {
+                current = net.points[v * net.size.x + u];
+            }
+
+            if (previous.x >= 0 && previous.y >= 0)
+            {
+                before = net.points[previous.y * net.size.x + previous.x];
+            }
+
+            auto coefficient = netDegree
+                * knotTables.getReciprocal(netDegree, alongU ? u : v);
+            derivative.points[v * derivative.size.x + u] =
+                coefficient * (current - before);
+        }
+    }
+
+    return derivative;
+}
+
+void BsplineSurface::evaluateTensorProduct(
+    int order,
+    int spanU,
+    const double *basisU,
+    int spanV,
+    const double *basisV,
+    SurfaceEvaluation &evaluation
+) const
+{
+    if (spanU < 0 || spanV < 0) { return; }
+
+    // derivative of order k on an axis is a spline of degree p - k over
+    // k-th derivative net, net point s is weighted by N(s, p - k)
+    auto supportSize = _degree + 1;
+    auto firstU = spanU - _degree;
+    auto firstV = spanV - _degree;
+
+    // products[u][v] holds mixed derivative of order u on U and v on V
+    glm::dvec3 products[MaxDerivativeOrder + 1][MaxDerivativeOrder + 1] = {};
+
+    for (auto ku = 0; ku <= order && ku <= _degree; ++ku)
+    {
+        for (auto kv = 0; ku + kv <= order && kv <= _degree; ++kv)
+        {
+            const auto &net = _derivativeNets[ku][kv];
+            auto weightsU = basisU + (_degree - ku) * supportSize;
+            auto weightsV = basisV + (_degree - kv) * supportSize;
+
+            // rows of net are combined on U first, then on V
+            for (auto j = std::max(kv, -firstV); j <= _degree; ++j)
+            {
+                auto v = firstV + j;
+                if (v >= net.size.y) { break; }
+
+                glm::dvec3 rowPoint{};
+                for (auto i = std::max(ku, -firstU); i <= _degree; ++i)
+                {
+                    auto u = firstU + i;
+                    if (u >= net.size.x) { break; }
+
+                    rowPoint += weightsU[i] * net.points[v * net.size.x + u];
+                }
+
+                products[ku][kv] += weightsV[j] * rowPoint;
+            }
+        }
+    }
+
+    evaluation.position = products[0][0];
+    if (order >= 1)
+    {
+        evaluation.derivativeU = products[1][0];
+        evaluation.derivativeV = products[0][1];
+    }
+
+    if (order >= 2)
+    {
+        evaluation.derivativeUU = products[2][0];
+        evaluation.derivativeUV = products[1][1];
+        evaluation.derivativeVV = products[0][2];
+    }
+}
 
 }
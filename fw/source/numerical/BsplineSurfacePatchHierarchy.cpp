@@ -0,0 +1,414 @@
+#include "fw/numerical/BsplineSurfacePatchHierarchy.hpp"
+
+#include <algorithm>
+#include <numeric>
+#include <utility>
+
+namespace fw
+{
+
+namespace
+{
+
+bool overlaps(const AABB<glm::dvec3> &lhs, const AABB<glm::dvec3> &rhs)
+{
+    return lhs.intersect(rhs).isValid();
+}
+
+AABB<glm::dvec3> merge(
+    const AABB<glm::dvec3> &lhs,
+    const AABB<glm::dvec3> &rhs
+)
+{
+    return {glm::min(lhs.min, rhs.min), glm::max(lhs.max, rhs.max)};
+}
+
+int findRoot(std::vector<int> &parents, int element)
+{
+    while (parents[element] != element)
+    {
+        parents[element] = parents[parents[element]];
+        element = parents[element];
+    }
+
+    return element;
+}
+
+// Groups pairs with touching overlaps and returns group of every pair,
+// groups are numbered in order of their first pair. Overlaps are swept
+// along the longest axis of their union, so only overlaps with common
+// range on that axis are compared.
+std::vector<int> groupTouchingOverlaps(
+    const std::vector<BsplineSurfacePatchPair> &pairs,
+    int &numGroups
+)
+{
+    numGroups = 0;
+    if (pairs.empty())
+    {
+        return {};
+    }
+
+    auto bounds = pairs.front().overlap;
+    for (const auto &pair: pairs)
+    {
+        bounds = merge(bounds, pair.overlap);
+    }
+
+    auto extent = bounds.max - bounds.min;
+    auto axis = extent.x >= extent.y
+        ? (extent.x >= extent.z ? 0 : 2)
+        : (extent.y >= extent.z ? 1 : 2);
+
+    std::vector<int> order(pairs.size());
+    std::iota(std::begin(order), std::end(order), 0);
+    std::sort(
+        std::begin(order),
+        std::end(order),
+        [&pairs, axis](int lhs, int rhs)
+        {
+            return pairs[lhs].overlap.min[axis] < pairs[rhs].overlap.min[axis];
+        }
+    );
+
+    std::vector<int> parents(pairs.size());
+    std::iota(std::begin(parents), std::end(parents), 0);
+
+    std::vector<int> active;
+    for (auto current: order)
+    {
+        const auto &overlap = pairs[current].overlap;
+        active.erase(
+            std::remove_if(
+                std::begin(active),
+                std::end(active),
+                [&](int other)
+                {
+                    return pairs[other].overlap.max[axis] < overlap.min[axis];
+                }
+            ),
+            std::end(active)
+        );
+
+        for (auto other: active)
+        {
+            if (overlaps(pairs[other].overlap, overlap))
+            {
+                parents[findRoot(parents, current)] = findRoot(parents, other);
+            }
+        }
+
+        active.push_back(current);
+    }
+
+    auto numPairs = static_cast<int>(pairs.size());
+    std::vector<int> groups(numPairs);
+    std::vector<int> rootGroups(numPairs, -1);
+    for (auto i = 0; i < numPairs; ++i)
+    {
+        auto root = findRoot(parents, i);
+        if (rootGroups[root] < 0)
+        {
+            rootGroups[root] = numGroups++;
+        }
+
+        groups[i] = rootGroups[root];
+    }
+
+    return groups;
+}
+
+}
+
+BsplineSurfacePatchHierarchy::BsplineSurfacePatchHierarchy(
+    const BsplineSurface& surface,
+    int maximumLeafPatches
+):
+    _maximumLeafPatches{std::max(1, maximumLeafPatches)}
+{
+    createPatches(surface);
+    if (!_patches.empty())
+    {
+        _nodes.reserve(2 * _patches.size());
+        _nodes.push_back({});
+        buildNode(0, 0, static_cast<int>(_patches.size()));
+    }
+}
+
+BsplineSurfacePatchHierarchy::~BsplineSurfacePatchHierarchy()
+{
+}
+
+bool BsplineSurfacePatchHierarchy::isEmpty() const
+{
+    return _nodes.empty();
+}
+
+AABB<glm::dvec3> BsplineSurfacePatchHierarchy::getBounds() const
+{
+    return _nodes.empty() ? AABB<glm::dvec3>{} : _nodes[0].bounds;
+}
+
+const std::vector<BsplineSurfacePatch> &
+        BsplineSurfacePatchHierarchy::getPatches() const
+{
+    return _patches;
+}
+
+std::vector<BsplineSurfacePatchPair>
+        BsplineSurfacePatchHierarchy::findOverlappingPatches(
+    const BsplineSurfacePatchHierarchy& other
+) const
+{
+    std::vector<BsplineSurfacePatchPair> pairs;
+    if (isEmpty() || other.isEmpty())
+    {
+        return pairs;
+    }
+
+    std::vector<std::pair<int, int>> stack{{0, 0}};
+    while (!stack.empty())
+    {
+        auto nodes = stack.back();
+        stack.pop_back();
+
+        const auto &lhsNode = _nodes[nodes.first];
+        const auto &rhsNode = other._nodes[nodes.second];
+
+        if (!overlaps(lhsNode.bounds, rhsNode.bounds))
+        {
+            continue;
+        }
+
+        auto lhsLeaf = lhsNode.firstChild < 0;
+        auto rhsLeaf = rhsNode.firstChild < 0;
+
+        if (lhsLeaf && rhsLeaf)
+        {
+            for (auto i = 0; i < lhsNode.numPatches; ++i)
+            {
+                auto lhsPatch = lhsNode.firstPatch + i;
+                for (auto j = 0; j < rhsNode.numPatches; ++j)
+                {
+                    auto rhsPatch = rhsNode.firstPatch + j;
+                    auto overlap = _patches[lhsPatch].bounds.intersect(
+                        other._patches[rhsPatch].bounds
+                    );
+
+                    if (overlap.isValid())
+                    {
+                        pairs.push_back({lhsPatch, rhsPatch, overlap});
+                    }
+                }
+            }
+
+            continue;
+        }
+
+        // descend into larger node first to keep pairs of similar size
+        auto lhsExtent = lhsNode.bounds.max - lhsNode.bounds.min;
+        auto rhsExtent = rhsNode.bounds.max - rhsNode.bounds.min;
+        auto splitLhs = rhsLeaf || (!lhsLeaf
+            && glm::dot(lhsExtent, lhsExtent)
+                >= glm::dot(rhsExtent, rhsExtent));
+
+        if (splitLhs)
+        {
+            stack.push_back({lhsNode.firstChild, nodes.second});
+            stack.push_back({lhsNode.firstChild + 1, nodes.second});
+        }
+        else
+        {
+            stack.push_back({nodes.first, rhsNode.firstChild});
+            stack.push_back({nodes.first, rhsNode.firstChild + 1});
+        }
+    }
+
+    return pairs;
+}
+
+std::vector<AABB<glm::dvec3>>
+        BsplineSurfacePatchHierarchy::findIntersectionSeedRegions(
+    const BsplineSurfacePatchHierarchy& other
+) const
+{
+    auto pairs = findOverlappingPatches(other);
+    auto numRegions = 0;
+    auto pairRegions = groupTouchingOverlaps(pairs, numRegions);
+
+    // regions are numbered in order of their first pair
+    std::vector<AABB<glm::dvec3>> regions;
+    regions.reserve(numRegions);
+    auto numPairs = static_cast<int>(pairs.size());
+    for (auto i = 0; i < numPairs; ++i)
+    {
+        if (pairRegions[i] == static_cast<int>(regions.size()))
+        {
+            regions.push_back(pairs[i].overlap);
+        }
+        else
+        {
+            auto &region = regions[pairRegions[i]];
+            region = merge(region, pairs[i].overlap);
+        }
+    }
+
+    return regions;
+}
+
+std::vector<IntersectionSeed>
+        BsplineSurfacePatchHierarchy::findIntersectionSeeds(
+    const BsplineSurfacePatchHierarchy& other
+) const
+{
+    auto pairs = findOverlappingPatches(other);
+    auto numRegions = 0;
+    auto pairRegions = groupTouchingOverlaps(pairs, numRegions);
+
+    auto numPairs = static_cast<int>(pairs.size());
+    std::vector<IntersectionSeed> seeds;
+    seeds.reserve(numPairs);
+    for (auto i = 0; i < numPairs; ++i)
+    {
+        seeds.push_back({
+            getUnitParameters(_patches[pairs[i].lhsPatch]),
+            other.getUnitParameters(other._patches[pairs[i].rhsPatch]),
+            pairs[i].overlap,
+            pairRegions[i]
+        });
+    }
+
+    std::stable_sort(
+        std::begin(seeds),
+        std::end(seeds),
+        [](const IntersectionSeed &lhs, const IntersectionSeed &rhs)
+        {
+            return lhs.region < rhs.region;
+        }
+    );
+
+    return seeds;
+}
+
+void BsplineSurfacePatchHierarchy::createPatches(
+    const BsplineSurface& surface
+)
+{
+    auto degree = surface.getDegree();
+    auto foldedGridSize = surface.getFoldedGridSize();
+    const auto &knotsU = surface.getKnotsOnU();
+    const auto &knotsV = surface.getKnotsOnV();
+
+    _parameterOrigin = {knotsU[degree], knotsV[degree]};
+    _parameterScale = glm::dvec2{
+        knotsU[knotsU.size() - degree - 1],
+        knotsV[knotsV.size() - degree - 1]
+    } - _parameterOrigin;
+
+    auto lastSpanU = std::min(
+        foldedGridSize.x,
+        static_cast<int>(knotsU.size()) - 1
+    );
+
+    auto lastSpanV = std::min(
+        foldedGridSize.y,
+        static_cast<int>(knotsV.size()) - 1
+    );
+
+    for (auto spanV = degree; spanV < lastSpanV; ++spanV)
+    {
+        if (knotsV[spanV] >= knotsV[spanV + 1]) { continue; }
+
+        for (auto spanU = degree; spanU < lastSpanU; ++spanU)
+        {
+            if (knotsU[spanU] >= knotsU[spanU + 1]) { continue; }
+
+            BsplineSurfacePatch patch;
+            patch.span = {spanU, spanV};
+            patch.minimumParameter = {knotsU[spanU], knotsV[spanV]};
+            patch.maximumParameter = {knotsU[spanU + 1], knotsV[spanV + 1]};
+
+            const auto &first = surface.getFoldedControlPoint(
+                spanU - degree,
+                spanV - degree
+            );
+            patch.bounds = {first, first};
+
+            for (auto v = spanV - degree; v <= spanV; ++v)
+            {
+                for (auto u = spanU - degree; u <= spanU; ++u)
+                {
+                    const auto &point = surface.getFoldedControlPoint(u, v);
+                    patch.bounds.min = glm::min(patch.bounds.min, point);
+                    patch.bounds.max = glm::max(patch.bounds.max, point);
+                }
+            }
+
+            _patches.push_back(patch);
+        }
+    }
+}
+
+glm::dvec2 BsplineSurfacePatchHierarchy::getUnitParameters(
+    const BsplineSurfacePatch& patch
+) const
+{
+    auto centre = 0.5 * (patch.minimumParameter + patch.maximumParameter);
+    return (centre - _parameterOrigin) / _parameterScale;
+}
+
+void BsplineSurfacePatchHierarchy::buildNode(
+    int nodeIndex,
+    int firstPatch,
+    int numPatches
+)
+{
+    auto patchesBegin = std::begin(_patches) + firstPatch;
+    auto patchesEnd = patchesBegin + numPatches;
+
+    auto bounds = patchesBegin->bounds;
+    for (auto it = patchesBegin; it != patchesEnd; ++it)
+    {
+        bounds = merge(bounds, it->bounds);
+    }
+
+    _nodes[nodeIndex].bounds = bounds;
+    _nodes[nodeIndex].firstChild = -1;
+    _nodes[nodeIndex].firstPatch = firstPatch;
+    _nodes[nodeIndex].numPatches = numPatches;
+
+    if (numPatches <= _maximumLeafPatches)
+    {
+        return;
+    }
+
+    // median split of patch centres along longest axis of the node
+    auto extent = bounds.max - bounds.min;
+    auto axis = extent.x >= extent.y
+        ? (extent.x >= extent.z ? 0 : 2)
+        : (extent.y >= extent.z ? 1 : 2);
+
+    auto half = numPatches / 2;
+    std::nth_element(
+        patchesBegin,
+        patchesBegin + half,
+        patchesEnd,
+        [axis](const BsplineSurfacePatch &lhs, const BsplineSurfacePatch &rhs)
+        {
+            return lhs.bounds.min[axis] + lhs.bounds.max[axis]
+                < rhs.bounds.min[axis] + rhs.bounds.max[axis];
+        }
+    );
+
+    // children are allocated next to each other, traversal relies on that
+    auto firstChild = static_cast<int>(_nodes.size());
+    _nodes.push_back({});
+    _nodes.push_back({});
+
+    _nodes[nodeIndex].firstChild = firstChild;
+
+    buildNode(firstChild, firstPatch, half);
+    buildNode(firstChild + 1, firstPatch + half, numPatches - half);
+}
+
+}
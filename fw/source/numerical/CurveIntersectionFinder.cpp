@@ -0,0 +1,646 @@
+#include "fw/numerical/CurveIntersectionFinder.hpp"
+#include "fw/numerical/BsplineKnotInsertion.hpp"
+#include "fw/numerical/DampedNewtonIterator.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace fw
+{
+
+namespace
+{
+
+double getDiagonal(const AABB<glm::dvec3> &bounds)
+{
+    return glm::length(bounds.max - bounds.min);
+}
+
+AABB<glm::dvec3> getPaddedBounds(const AABB<glm::dvec3> &bounds, double pad)
+{
+    glm::dvec3 padding{pad, pad, pad};
+    return {bounds.min - padding, bounds.max + padding};
+}
+
+// Part of a curve segment (or surface patch) produced by subdivision.
+template <typename TPart>
+struct Piece
+{
+public:
+    int source;
+    TPart part;
+    AABB<glm::dvec3> bounds;
+};
+
+template <typename TPart>
+int addPiece(std::vector<Piece<TPart>> &pieces, int source, const TPart &part)
+{
+    pieces.push_back({source, part, part.getBounds()});
+    return static_cast<int>(pieces.size()) - 1;
+}
+
+struct Candidate
+{
+public:
+    int lhsPiece;
+    int rhsPiece;
+    int depth;
+};
+
+// Equation system C(t) - S(u, v) = 0, parameters are (t, u, v). Curve is
+// evaluated on single Bezier segment, so parameters are clamped to it.
+class CurveSurfaceNewtonIterable:
+    public INewtonIterable<glm::dvec3, glm::dvec3, glm::dmat3>
+{
+public:
+    CurveSurfaceNewtonIterable(
+        const BezierCurveSegment &segment,
+        const BsplineSurface &surface,
+        const AABB<glm::dvec2> &surfaceDomain,
+        double parameterTolerance
+    ):
+        _segment(segment),
+        _surface(surface),
+        _surfaceDomain{surfaceDomain},
+        _parameterTolerance{parameterTolerance}
+    {
+    }
+
+    virtual void setInitialParameters(const glm::dvec3&) override
+    {
+    }
+
+    virtual void setCurrentParameters(const glm::dvec3& parameters) override
+    {
+        _parameters = parameters;
+        _curvePosition = _segment.getPosition(parameters.x);
+        _curveDerivative = _segment.getDerivative(parameters.x);
+        _surfaceEvaluation = _surface.evaluate({parameters.y, parameters.z}, 1);
+    }
+
+    virtual bool hasParameterConverged(
+        const glm::dvec3& newParameters
+    ) const override
+    {
+        return glm::length(newParameters - _parameters) < _parameterTolerance;
+    }
+
+    virtual bool areParametersValid(
+        const glm::dvec3& parameters
+    ) const override
+    {
+        return !std::isnan(parameters.x)
+            && !std::isnan(parameters.y)
+            && !std::isnan(parameters.z);
+    }
+
+    virtual glm::dvec3 evaluateFunction() const override
+    {
+        return _curvePosition - _surfaceEvaluation.position;
+    }
+
+    virtual glm::dmat3 getJacobian() const override
+    {
+        return glm::dmat3{
+            _curveDerivative,
+            -_surfaceEvaluation.derivativeU,
+            -_surfaceEvaluation.derivativeV
+        };
+    }
+
+    virtual glm::dmat3 getJacobianInverse() const override
+    {
+        return glm::inverse(getJacobian());
+    }
+
+    virtual glm::dvec3 correctParametrisation(
+        const glm::dvec3& parameters
+    ) const override
+    {
+        return {
+            glm::clamp(
+                parameters.x,
+                _segment.minimumParameter,
+                _segment.maximumParameter
+            ),
+            glm::clamp(
+                parameters.y,
+                _surfaceDomain.min.x,
+                _surfaceDomain.max.x
+            ),
+            glm::clamp(
+                parameters.z,
+                _surfaceDomain.min.y,
+                _surfaceDomain.max.y
+            )
+        };
+    }
+
+private:
+    const BezierCurveSegment &_segment;
+    const BsplineSurface &_surface;
+    AABB<glm::dvec2> _surfaceDomain;
+    double _parameterTolerance;
+    glm::dvec3 _parameters;
+    glm::dvec3 _curvePosition;
+    glm::dvec3 _curveDerivative;
+    SurfaceEvaluation _surfaceEvaluation;
+};
+
+// Curves in space generally miss each other, so closest points of
+// A(s) - B(t) are searched instead (Gauss-Newton). Function is gradient of
+// 0.5 * |A(s) - B(t)|^2 and its jacobian drops second derivative terms,
+// which vanish at intersections anyway.
+class CurveCurveNewtonIterable:
+    public INewtonIterable<glm::dvec2, glm::dvec2, glm::dmat2>
+{
+public:
+    CurveCurveNewtonIterable(
+        const BezierCurveSegment &lhs,
+        const BezierCurveSegment &rhs,
+        double parameterTolerance
+    ):
+        _lhs(lhs),
+        _rhs(rhs),
+        _parameterTolerance{parameterTolerance}
+    {
+    }
+
+    virtual void setInitialParameters(const glm::dvec2&) override
+    {
+    }
+
+    virtual void setCurrentParameters(const glm::dvec2& parameters) override
+    {
+        _parameters = parameters;
+        _difference = _lhs.getPosition(parameters.x)
+            - _rhs.getPosition(parameters.y);
+        _lhsDerivative = _lhs.getDerivative(parameters.x);
+        _rhsDerivative = _rhs.getDerivative(parameters.y);
+    }
+
+    virtual bool hasParameterConverged(
+        const glm::dvec2& newParameters
+    ) const override
+    {
+        return glm::length(newParameters - _parameters) < _parameterTolerance;
+    }
+
+    virtual bool areParametersValid(
+        const glm::dvec2& parameters
+    ) const override
+    {
+        return !std::isnan(parameters.x) && !std::isnan(parameters.y);
+    }
+
+    virtual glm::dvec2 evaluateFunction() const override
+    {
+        return {
+            glm::dot(_lhsDerivative, _difference),
+            -glm::dot(_rhsDerivative, _difference)
+        };
+    }
+
+    virtual glm::dmat2 getJacobian() const override
+    {
+        auto mixed = -glm::dot(_lhsDerivative, _rhsDerivative);
+        return glm::dmat2{
+            {glm::dot(_lhsDerivative, _lhsDerivative), mixed},
+            {mixed, glm::dot(_rhsDerivative, _rhsDerivative)}
+        };
+    }
+
+    virtual glm::dmat2 getJacobianInverse() const override
+    {
+        return glm::inverse(getJacobian());
+    }
+
+    virtual glm::dvec2 correctParametrisation(
+        const glm::dvec2& parameters
+    ) const override
+    {
+        return {
+            glm::clamp(
+                parameters.x,
+                _lhs.minimumParameter,
+                _lhs.maximumParameter
+            ),
+            glm::clamp(
+                parameters.y,
+                _rhs.minimumParameter,
+                _rhs.maximumParameter
+            )
+        };
+    }
+
+private:
+    const BezierCurveSegment &_lhs;
+    const BezierCurveSegment &_rhs;
+    double _parameterTolerance;
+    glm::dvec2 _parameters;
+    glm::dvec3 _difference;
+    glm::dvec3 _lhsDerivative;
+    glm::dvec3 _rhsDerivative;
+};
+
+AABB<glm::dvec2> getSurfaceDomain(
+    const std::vector<BezierSurfacePatch> &patches
+)
+{
+    AABB<glm::dvec2> domain{
+        patches.front().minimumParameter,
+        patches.front().maximumParameter
+    };
+
+    for (const auto &patch: patches)
+    {
+        domain.min = glm::min(domain.min, patch.minimumParameter);
+        domain.max = glm::max(domain.max, patch.maximumParameter);
+    }
+
+    return domain;
+}
+
+}
+
+CurveIntersectionSettings::CurveIntersectionSettings():
+    seedSize{0.01},
+    maximumDepth{32},
+    newtonIterationLimit{16},
+    distanceTolerance{1e-7},
+    parameterTolerance{1e-7}
+{
+}
+
+CurveIntersectionFinder::CurveIntersectionFinder():
+    _newtonSolvesCount{0}
+{
+}
+
+CurveIntersectionFinder::~CurveIntersectionFinder()
+{
+}
+
+const CurveIntersectionSettings &CurveIntersectionFinder::getSettings() const
+{
+    return _settings;
+}
+
+void CurveIntersectionFinder::setSettings(
+    const CurveIntersectionSettings &settings
+)
+{
+    _settings = settings;
+}
+
+int CurveIntersectionFinder::getNewtonSolvesCount() const
+{
+    return _newtonSolvesCount;
+}
+
+std::vector<CurveSurfaceIntersection> CurveIntersectionFinder::intersect(
+    const std::vector<BezierCurveSegment> &curve,
+    const BsplineSurface &surface
+)
+{
+    _newtonSolvesCount = 0;
+
+    std::vector<CurveSurfaceIntersection> intersections;
+    auto patches = decomposeIntoBezierPatches(surface);
+    if (curve.empty() || patches.empty())
+    {
+        return intersections;
+    }
+
+    auto surfaceDomain = getSurfaceDomain(patches);
+
+    std::vector<Piece<BezierCurveSegment>> curvePieces;
+    std::vector<Piece<BezierSurfacePatch>> surfacePieces;
+    std::vector<Candidate> candidates;
+
+    auto numCurvePieces = static_cast<int>(curve.size());
+    for (auto i = 0; i < numCurvePieces; ++i)
+    {
+        addPiece(curvePieces, i, curve[i]);
+    }
+
+    auto numSurfacePieces = static_cast<int>(patches.size());
+    for (auto i = 0; i < numSurfacePieces; ++i)
+    {
+        addPiece(surfacePieces, i, patches[i]);
+    }
+
+    for (auto i = 0; i < numCurvePieces; ++i)
+    {
+        for (auto j = 0; j < numSurfacePieces; ++j)
+        {
+            candidates.push_back({i, j, 0});
+        }
+    }
+
+    DampedNewtonIterator<glm::dvec3, glm::dvec3, glm::dmat3> newtonIterator;
+    newtonIterator.setIterationLimit(_settings.newtonIterationLimit);
+
+    while (!candidates.empty())
+    {
+        auto candidate = candidates.back();
+        candidates.pop_back();
+
+        const auto curveBounds = curvePieces[candidate.lhsPiece].bounds;
+        const auto surfaceBounds = surfacePieces[candidate.rhsPiece].bounds;
+        auto overlap = getPaddedBounds(
+            curveBounds,
+            _settings.distanceTolerance
+        ).intersect(surfaceBounds);
+
+        if (!overlap.isValid())
+        {
+            continue;
+        }
+
+        auto curveDiagonal = getDiagonal(curveBounds);
+        auto surfaceDiagonal = getDiagonal(surfaceBounds);
+        auto isCurveSmall = curveDiagonal <= _settings.seedSize;
+        auto isSurfaceSmall = surfaceDiagonal <= _settings.seedSize;
+
+        if (!(isCurveSmall && isSurfaceSmall)
+            && candidate.depth < _settings.maximumDepth)
+        {
+            auto depth = candidate.depth + 1;
+            if (!isCurveSmall && curveDiagonal >= surfaceDiagonal)
+            {
+                auto piece = curvePieces[candidate.lhsPiece];
+                BezierCurveSegment lower, upper;
+                piece.part.split(
+                    0.5 * (piece.part.minimumParameter
+                        + piece.part.maximumParameter),
+                    lower,
+                    upper
+                );
+
+                for (const auto &part: {lower, upper})
+                {
+                    candidates.push_back({
+                        addPiece(curvePieces, piece.source, part),
+                        candidate.rhsPiece,
+                        depth
+                    });
+                }
+            }
+            else
+            {
+                auto piece = surfacePieces[candidate.rhsPiece];
+                auto middle = 0.5 * (piece.part.minimumParameter
+                    + piece.part.maximumParameter);
+
+                BezierSurfacePatch lower, upper, quarters[4];
+                piece.part.split(
+                    ParametrizationAxis::U,
+                    middle.x,
+                    lower,
+                    upper
+                );
+                lower.split(
+                    ParametrizationAxis::V,
+                    middle.y,
+                    quarters[0],
+                    quarters[1]
+                );
+                upper.split(
+                    ParametrizationAxis::V,
+                    middle.y,
+                    quarters[2],
+                    quarters[3]
+                );
+
+                for (const auto &part: quarters)
+                {
+                    candidates.push_back({
+                        candidate.lhsPiece,
+                        addPiece(surfacePieces, piece.source, part),
+                        depth
+                    });
+                }
+            }
+
+            continue;
+        }
+
+        const auto &curvePiece = curvePieces[candidate.lhsPiece];
+        const auto &surfacePiece = surfacePieces[candidate.rhsPiece];
+        const auto &segment = curve[curvePiece.source];
+        CurveSurfaceNewtonIterable iterable{
+            segment,
+            surface,
+            surfaceDomain,
+            _settings.parameterTolerance
+        };
+
+        auto surfaceStart = 0.5 * (surfacePiece.part.minimumParameter
+            + surfacePiece.part.maximumParameter);
+        auto result = newtonIterator.iterate(
+            iterable,
+            {
+                0.5 * (curvePiece.part.minimumParameter
+                    + curvePiece.part.maximumParameter),
+                surfaceStart.x,
+                surfaceStart.y
+            }
+        );
+        ++_newtonSolvesCount;
+
+        const auto &parameters = result.parameters;
+        auto curvePosition = segment.getPosition(parameters.x);
+        auto surfaceParameters = glm::dvec2{parameters.y, parameters.z};
+        auto distance = glm::length(
+            curvePosition - surface.getPosition(surfaceParameters)
+        );
+
+        if (!(distance <= _settings.distanceTolerance))
+        {
+            continue;
+        }
+
+        auto isDuplicate = std::any_of(
+            std::begin(intersections),
+            std::end(intersections),
+            [&](const CurveSurfaceIntersection &found)
+            {
+                return std::abs(found.curveParameter - parameters.x)
+                        <= _settings.parameterTolerance
+                    && glm::length(found.surfaceParameters - surfaceParameters)
+                        <= _settings.parameterTolerance;
+            }
+        );
+
+        if (!isDuplicate)
+        {
+            intersections.push_back({
+                parameters.x,
+                surfaceParameters,
+                curvePosition
+            });
+        }
+    }
+
+    std::sort(
+        std::begin(intersections),
+        std::end(intersections),
+        [](const CurveSurfaceIntersection &a, const CurveSurfaceIntersection &b)
+        {
+            return a.curveParameter < b.curveParameter;
+        }
+    );
+
+    return intersections;
+}
+
+std::vector<CurveCurveIntersection> CurveIntersectionFinder::intersect(
+    const std::vector<BezierCurveSegment> &lhs,
+    const std::vector<BezierCurveSegment> &rhs
+)
+{
+    _newtonSolvesCount = 0;
+
+    std::vector<CurveCurveIntersection> intersections;
+    std::vector<Piece<BezierCurveSegment>> pieces;
+    std::vector<Candidate> candidates;
+
+    auto numLhsPieces = static_cast<int>(lhs.size());
+    for (auto i = 0; i < numLhsPieces; ++i)
+    {
+        addPiece(pieces, i, lhs[i]);
+    }
+
+    auto numRhsPieces = static_cast<int>(rhs.size());
+    for (auto i = 0; i < numRhsPieces; ++i)
+    {
+        addPiece(pieces, i, rhs[i]);
+    }
+
+    for (auto i = 0; i < numLhsPieces; ++i)
+    {
+        for (auto j = 0; j < numRhsPieces; ++j)
+        {
+            candidates.push_back({i, numLhsPieces + j, 0});
+        }
+    }
+
+    DampedNewtonIterator<glm::dvec2, glm::dvec2, glm::dmat2> newtonIterator;
+    newtonIterator.setIterationLimit(_settings.newtonIterationLimit);
+
+    while (!candidates.empty())
+    {
+        auto candidate = candidates.back();
+        candidates.pop_back();
+
+        const auto lhsBounds = pieces[candidate.lhsPiece].bounds;
+        const auto rhsBounds = pieces[candidate.rhsPiece].bounds;
+        auto overlap = getPaddedBounds(
+            lhsBounds,
+            _settings.distanceTolerance
+        ).intersect(rhsBounds);
+
+        if (!overlap.isValid())
+        {
+            continue;
+        }
+
+        auto lhsDiagonal = getDiagonal(lhsBounds);
+        auto rhsDiagonal = getDiagonal(rhsBounds);
+        auto isLhsSmall = lhsDiagonal <= _settings.seedSize;
+        auto isRhsSmall = rhsDiagonal <= _settings.seedSize;
+
+        if (!(isLhsSmall && isRhsSmall)
+            && candidate.depth < _settings.maximumDepth)
+        {
+            auto splitLhs = !isLhsSmall && lhsDiagonal >= rhsDiagonal;
+            auto pieceIndex = splitLhs
+                ? candidate.lhsPiece
+                : candidate.rhsPiece;
+            auto piece = pieces[pieceIndex];
+
+            BezierCurveSegment lower, upper;
+            piece.part.split(
+                0.5 * (piece.part.minimumParameter
+                    + piece.part.maximumParameter),
+                lower,
+                upper
+            );
+
+            for (const auto &part: {lower, upper})
+            {
+                auto partIndex = addPiece(pieces, piece.source, part);
+                candidates.push_back({
+                    splitLhs ? partIndex : candidate.lhsPiece,
+                    splitLhs ? candidate.rhsPiece : partIndex,
+                    candidate.depth + 1
+                });
+            }
+
+            continue;
+        }
+
+        const auto &lhsPiece = pieces[candidate.lhsPiece];
+        const auto &rhsPiece = pieces[candidate.rhsPiece];
+        const auto &lhsSegment = lhs[lhsPiece.source];
+        const auto &rhsSegment = rhs[rhsPiece.source];
+        CurveCurveNewtonIterable iterable{
+            lhsSegment,
+            rhsSegment,
+            _settings.parameterTolerance
+        };
+
+        auto result = newtonIterator.iterate(
+            iterable,
+            {
+                0.5 * (lhsPiece.part.minimumParameter
+                    + lhsPiece.part.maximumParameter),
+                0.5 * (rhsPiece.part.minimumParameter
+                    + rhsPiece.part.maximumParameter)
+            }
+        );
+        ++_newtonSolvesCount;
+
+        const auto &parameters = result.parameters;
+        auto lhsPosition = lhsSegment.getPosition(parameters.x);
+        auto distance = glm::length(
+            lhsPosition - rhsSegment.getPosition(parameters.y)
+        );
+
+        if (!(distance <= _settings.distanceTolerance))
+        {
+            continue;
+        }
+
+        auto isDuplicate = std::any_of(
+            std::begin(intersections),
+            std::end(intersections),
+            [&](const CurveCurveIntersection &found)
+            {
+                return std::abs(found.lhsParameter - parameters.x)
+                        <= _settings.parameterTolerance
+                    && std::abs(found.rhsParameter - parameters.y)
+                        <= _settings.parameterTolerance;
+            }
+        );
+
+        if (!isDuplicate)
+        {
+            intersections.push_back({parameters.x, parameters.y, lhsPosition});
+        }
+    }
+
+    std::sort(
+        std::begin(intersections),
+        std::end(intersections),
+        [](const CurveCurveIntersection &a, const CurveCurveIntersection &b)
+        {
+            return a.lhsParameter < b.lhsParameter;
+        }
+    );
+
+    return intersections;
+}
+
+}
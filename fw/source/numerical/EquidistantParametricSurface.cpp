@@ -1,34 +1,69 @@
 #include "fw/numerical/EquidistantParametricSurface.hpp"
 
+#include <algorithm>
+#include <limits>
+
 namespace fw
 {
 
+constexpr int EquidistantParametricSurface::MaxDerivativeOrder;
+
 EquidistantParametricSurfaceCurve::EquidistantParametricSurfaceCurve(
     std::shared_ptr<const EquidistantParametricSurface> referenceSurface,
     ParametrizationAxis constantAxis,
-    double constantParameter
+    double constantParameter,
+    int derivativeOrder
 ):
     _referenceSurface{referenceSurface},
     _constantAxis{constantAxis},
-    _constantParameter{constantParameter}
+    _constantParameter{constantParameter},
+    _derivativeOrder{derivativeOrder}
 {
 }
 
 glm::dvec3 EquidistantParametricSurfaceCurve::evaluate(double parameter) const
 {
-    auto parameterization = _constantAxis == ParametrizationAxis::U
+    if (_derivativeOrder > EquidistantParametricSurface::MaxDerivativeOrder)
+    {
+        const double step = 1e-5;
+        EquidistantParametricSurfaceCurve lowerOrder{
+            _referenceSurface,
+            _constantAxis,
+            _constantParameter,
+            _derivativeOrder - 1
+        };
+
+        return (lowerOrder.evaluate(parameter + step)
+            - lowerOrder.evaluate(parameter - step)) / (2.0 * step);
+    }
+
+    auto isConstantU = _constantAxis == ParametrizationAxis::U;
+    auto parameterization = isConstantU
         ? glm::dvec2{_constantParameter, parameter}
         : glm::dvec2{parameter, _constantParameter};
-    return _referenceSurface->getPosition(parameterization);
+
+    auto evaluation = _referenceSurface->evaluate(
+        parameterization,
+        _derivativeOrder
+    );
+
+    if (_derivativeOrder == 0)
+    {
+        return evaluation.position;
+    }
+
+    return isConstantU ? evaluation.derivativeV : evaluation.derivativeU;
 }
 
 std::shared_ptr<ICurve3d> EquidistantParametricSurfaceCurve::getDerivativeCurve(
 ) const
 {
-    return _referenceSurface
-        ->getReferenceSurface()
-        ->getConstParameterCurve(_constantAxis, _constantParameter)
-        ->getDerivativeCurve();
+    return std::make_shared<EquidistantParametricSurfaceCurve>(
+        _referenceSurface,
+        _constantAxis,
+        _constantParameter,
+        _derivativeOrder + 1
+    );
 }
 
 EquidistantParametricSurface::EquidistantParametricSurface(
@@ -50,6 +85,11 @@ std::shared_ptr<fw::IParametricSurfaceUV>
     return _referenceSurface;
 }
 
+bool EquidistantParametricSurface::isPeriodic(ParametrizationAxis axis) const
+{
+    return _referenceSurface->isPeriodic(axis);
+}
+
 std::shared_ptr<ICurve3d> EquidistantParametricSurface::getConstParameterCurve(
     ParametrizationAxis constParameter,
     double parameter
@@ -68,36 +108,120 @@ glm::dvec3 EquidistantParametricSurface::getPosition(
     glm::dvec2 parametrisation
 ) const
 {
-    const auto& originalPosition = _referenceSurface->getPosition(
-        parametrisation
-    );
-
-    const auto& normal = getNormal(parametrisation);
-
-    return originalPosition + _normalDistance * normal;
+    return evaluate(parametrisation, 0).position;
 }
 
 glm::dvec3 EquidistantParametricSurface::getNormal(
     glm::dvec2 parametrisation
 ) const
 {
-    return glm::normalize(_referenceSurface->getNormal(parametrisation));
+    // offset surface is parallel to the reference one
+    return _referenceSurface->evaluate(parametrisation, 1).getNormal();
 }
 
 glm::dvec3 EquidistantParametricSurface::getDerivativeU(
     glm::dvec2 parameterization
 ) const
 {
-    // todo: verify if those derivatives are correct
-    return _referenceSurface->getDerivativeU(parameterization);
+    return evaluate(parameterization, 1).derivativeU;
 }
 
 glm::dvec3 EquidistantParametricSurface::getDerivativeV(
     glm::dvec2 parameterization
 ) const
 {
-    // todo: verify if those derivatives are correct
-    return _referenceSurface->getDerivativeV(parameterization);
+    return evaluate(parameterization, 1).derivativeV;
+}
+
+SurfaceEvaluation EquidistantParametricSurface::evaluate(
+    glm::dvec2 parametrisation,
+    int order
+) const
+{
+    order = std::max(0, std::min(order, MaxDerivativeOrder));
+
+    // normal requires first derivatives of reference surface, derivatives
+    // of the normal require second ones
+    auto reference = _referenceSurface->evaluate(parametrisation, order + 1);
+    auto normal = reference.getNormal();
+
+    SurfaceEvaluation evaluation;
+    evaluation.order = order;
+    evaluation.position = reference.position + _normalDistance * normal;
+
+    if (order < 1)
+    {
+        return evaluation;
+    }
+
+    const auto &su = reference.derivativeU;
+    const auto &sv = reference.derivativeV;
+
+    // first and second fundamental forms
+    auto e = glm::dot(su, su);
+    auto f = glm::dot(su, sv);
+    auto g = glm::dot(sv, sv);
+    auto l = glm::dot(reference.derivativeUU, normal);
+    auto m = glm::dot(reference.derivativeUV, normal);
+    auto n = glm::dot(reference.derivativeVV, normal);
+    auto determinant = e * g - f * f;
+
+    evaluation.derivativeU = su;
+    evaluation.derivativeV = sv;
+
+    // normal is undefined at singular points, offset moves rigidly there,
+    // threshold is relative to scale of the parametrisation
+    if (determinant <= std::numeric_limits<double>::epsilon() * e * g)
+    {
+        return evaluation;
+    }
+
+    // Weingarten equations
+    auto normalU = ((m * f - l * g) * su + (l * f - m * e) * sv)
+        / determinant;
+    auto normalV = ((n * f - m * g) * su + (m * f - n * e) * sv)
+        / determinant;
+
+    evaluation.derivativeU += _normalDistance * normalU;
+    evaluation.derivativeV += _normalDistance * normalV;
+    return evaluation;
+}
+
+void EquidistantParametricSurface::sampleGridRows(
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter,
+    glm::ivec2 resolution,
+    int firstRow,
+    int numRows,
+    glm::dvec3 *positions,
+    glm::dvec3 *normals
+) const
+{
+    auto numSamples = numRows * resolution.x;
+    std::vector<glm::dvec3> referenceNormals(numSamples);
+    _referenceSurface->sampleGridRows(
+        minimumParameter,
+        maximumParameter,
+        resolution,
+        firstRow,
+        numRows,
+        positions,
+        referenceNormals.data()
+    );
+
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        positions[i] += _normalDistance * referenceNormals[i];
+    }
+
+    if (normals != nullptr)
+    {
+        std::copy(
+            std::begin(referenceNormals),
+            std::end(referenceNormals),
+            normals
+        );
+    }
 }
 
 }
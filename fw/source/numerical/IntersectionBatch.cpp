@@ -0,0 +1,131 @@
+#include "fw/numerical/IntersectionBatch.hpp"
+
+#include <future>
+
+namespace fw
+{
+
+IntersectionBatch::IntersectionBatch()
+{
+}
+
+IntersectionBatch::~IntersectionBatch()
+{
+}
+
+void IntersectionBatch::setThreadPool(std::shared_ptr<ThreadPool> threadPool)
+{
+    _threadPool = threadPool;
+}
+
+std::shared_ptr<ThreadPool> IntersectionBatch::getThreadPool() const
+{
+    return _threadPool;
+}
+
+void IntersectionBatch::setTracingSettings(
+    const IntersectionTracingSettings &settings
+)
+{
+    _settings = settings;
+}
+
+int IntersectionBatch::addPair(
+    const std::shared_ptr<IParametricSurfaceUV> lhs,
+    const std::shared_ptr<IParametricSurfaceUV> rhs,
+    const std::vector<AABB<glm::dvec3>> &seedRegions
+)
+{
+    _pairs.push_back({lhs, rhs, seedRegions, {}});
+    return static_cast<int>(_pairs.size()) - 1;
+}
+
+int IntersectionBatch::addPair(
+    const std::shared_ptr<IParametricSurfaceUV> lhs,
+    const std::shared_ptr<IParametricSurfaceUV> rhs,
+    const std::vector<IntersectionSeed> &seeds
+)
+{
+    _pairs.push_back({lhs, rhs, {}, seeds});
+    return static_cast<int>(_pairs.size()) - 1;
+}
+
+int IntersectionBatch::addPair(
+    const std::shared_ptr<IParametricSurfaceUV> lhs,
+    const std::shared_ptr<IParametricSurfaceUV> rhs,
+    glm::dvec3 neighbourhoodPoint
+)
+{
+    return addPair(
+        lhs,
+        rhs,
+        std::vector<AABB<glm::dvec3>>{{neighbourhoodPoint, neighbourhoodPoint}}
+    );
+}
+
+int IntersectionBatch::getNumPairs() const
+{
+    return static_cast<int>(_pairs.size());
+}
+
+void IntersectionBatch::clear()
+{
+    _pairs.clear();
+}
+
+std::vector<IntersectionBatchResult> IntersectionBatch::run() const
+{
+    auto numPairs = static_cast<int>(_pairs.size());
+    std::vector<IntersectionBatchResult> results(numPairs);
+
+    if (_threadPool == nullptr || _threadPool->getNumThreads() <= 1)
+    {
+        for (auto i = 0; i < numPairs; ++i)
+        {
+            results[i] = intersectPair(_pairs[i]);
+        }
+
+        return results;
+    }
+
+    // pair costs vary a lot, so each pair is queued separately and idle
+    // workers pick up next one
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(numPairs);
+
+    for (auto i = 0; i < numPairs; ++i)
+    {
+        tasks.push_back(_threadPool->enqueue([this, &results, i]() {
+            results[i] = intersectPair(_pairs[i]);
+        }));
+    }
+
+    for (auto &task: tasks)
+    {
+        task.wait();
+    }
+
+    for (auto &task: tasks)
+    {
+        task.get();
+    }
+
+    return results;
+}
+
+IntersectionBatchResult IntersectionBatch::intersectPair(
+    const IntersectionBatchPair &pair
+) const
+{
+    ParametricSurfaceIntersectionFinder finder;
+    finder.setTracingSettings(_settings);
+
+    IntersectionBatchResult result;
+    result.curves = pair.seeds.empty()
+        ? finder.intersect(pair.lhs, pair.rhs, pair.seedRegions)
+        : finder.intersect(pair.lhs, pair.rhs, pair.seeds);
+    result.tracingStops = finder.getTracingStops();
+    return result;
+}
+
+}
@@ -1,5 +1,6 @@
 #include "fw/numerical/IntersectionCurve.hpp"
 #include <algorithm>
+#include <cmath>
 
 namespace fw
 {
@@ -7,7 +8,9 @@ namespace fw
 IntersectionCurve::IntersectionCurve():
     _isLoopBackEnabled{false},
     _loopBackDistance{},
-    _minIndexDiff{}
+    _minArcLength{},
+    _minIndexDiff{},
+    _cellSize{}
 {
 }
 
@@ -28,6 +31,17 @@ void IntersectionCurve::setLoopbackMinimumIndexDifference(int minIndexDiff)
 void IntersectionCurve::setLoopBackDistance(double loopBackDistance)
 {
     _loopBackDistance = loopBackDistance;
+
+    if (_loopBackDistance > _cellSize)
+    {
+        // geometric growth keeps amount of rebuilds logarithmic
+        rebuildPointsIndex(std::max(_loopBackDistance, 2.0 * _cellSize));
+    }
+}
+
+void IntersectionCurve::setLoopBackMinimumArcLength(double minArcLength)
+{
+    _minArcLength = minArcLength;
 }
 
 IntersectionCurveAddingResult IntersectionCurve::addCurvePoint(
@@ -39,16 +53,17 @@ IntersectionCurveAddingResult IntersectionCurve::addCurvePoint(
         auto connectableIndex = findConnectablePoint(intersection);
         if (connectableIndex >= 0)
         {
-            _curvePoints.push_back(_curvePoints[connectableIndex]);
+            auto connectablePoint = _curvePoints[connectableIndex];
+            appendCurvePoint(connectablePoint);
             return IntersectionCurveAddingResult::LoopedBack;
         }
     }
 
-    _curvePoints.push_back(intersection);
+    appendCurvePoint(intersection);
     return IntersectionCurveAddingResult::Success;
 }
 
-const std::vector<ParametricSurfaceIntersection>
+const std::vector<ParametricSurfaceIntersection> &
         IntersectionCurve::getCurvePoints() const
 {
     return _curvePoints;
@@ -57,6 +72,15 @@ const std::vector<ParametricSurfaceIntersection>
 void IntersectionCurve::reverse()
 {
     std::reverse(std::begin(_curvePoints), std::end(_curvePoints));
+
+    auto totalArcLength = _arcLengths.empty() ? 0.0 : _arcLengths.back();
+    std::reverse(std::begin(_arcLengths), std::end(_arcLengths));
+    for (auto &arcLength: _arcLengths)
+    {
+        arcLength = totalArcLength - arcLength;
+    }
+
+    rebuildPointsIndex(_cellSize);
 }
 
 int IntersectionCurve::findConnectablePoint(
@@ -65,18 +89,109 @@ int IntersectionCurve::findConnectablePoint(
 {
     if (_curvePoints.size() < _minIndexDiff) { return -1; }
 
-    for (auto i = 0; i < _curvePoints.size() - _minIndexDiff; ++i)
-    {
-        auto diffVector =
-            _curvePoints[i].scenePosition - intersection.scenePosition;
+    // without positive loop back distance no point is in range and there
+    // is no grid to look up
+    if (_cellSize <= 0.0) { return -1; }
+
+    auto lastConnectableIndex =
+        static_cast<int>(_curvePoints.size()) - _minIndexDiff;
+    auto lastConnectableArcLength =
+        getArcLengthTo(intersection.scenePosition) - _minArcLength;
+    auto centerCell = getCell(intersection.scenePosition);
+    auto connectableIndex = -1;
 
-        if (glm::length(diffVector) < _loopBackDistance)
+    // earliest matching point is chosen, same as in sequential scan
+    for (auto z = -1; z <= 1; ++z)
+    {
+        for (auto y = -1; y <= 1; ++y)
         {
-            return i;
+            for (auto x = -1; x <= 1; ++x)
+            {
+                auto bucket = _pointsIndex.find(
+                    getCellKey(centerCell + glm::ivec3{x, y, z})
+                );
+
+                if (bucket == _pointsIndex.end()) { continue; }
+
+                for (auto index: bucket->second)
+                {
+                    if (index >= lastConnectableIndex) { break; }
+                    if (_arcLengths[index] > lastConnectableArcLength)
+                    {
+                        break;
+                    }
+
+                    if (connectableIndex >= 0 && index >= connectableIndex)
+                    {
+                        break;
+                    }
+
+                    auto diffVector = _curvePoints[index].scenePosition
+                        - intersection.scenePosition;
+
+                    if (glm::length(diffVector) < _loopBackDistance)
+                    {
+                        connectableIndex = index;
+                    }
+                }
+            }
         }
     }
 
-    return -1;
+    return connectableIndex;
+}
+
+void IntersectionCurve::rebuildPointsIndex(double cellSize)
+{
+    _cellSize = cellSize;
+    _pointsIndex.clear();
+
+    auto numPoints = static_cast<int>(_curvePoints.size());
+    for (auto i = 0; i < numPoints; ++i)
+    {
+        addToPointsIndex(i);
+    }
+}
+
+void IntersectionCurve::appendCurvePoint(
+    const ParametricSurfaceIntersection& intersection
+)
+{
+    _arcLengths.push_back(getArcLengthTo(intersection.scenePosition));
+    _curvePoints.push_back(intersection);
+    addToPointsIndex(static_cast<int>(_curvePoints.size()) - 1);
+}
+
+double IntersectionCurve::getArcLengthTo(const glm::dvec3 &position) const
+{
+    if (_curvePoints.empty()) { return 0.0; }
+    return _arcLengths.back()
+        + glm::length(position - _curvePoints.back().scenePosition);
+}
+
+void IntersectionCurve::addToPointsIndex(int pointIndex)
+{
+    if (_cellSize <= 0.0) { return; }
+
+    // indices in buckets stay sorted, points are only appended
+    auto cell = getCell(_curvePoints[pointIndex].scenePosition);
+    _pointsIndex[getCellKey(cell)].push_back(pointIndex);
+}
+
+glm::ivec3 IntersectionCurve::getCell(const glm::dvec3 &position) const
+{
+    return {
+        static_cast<int>(std::floor(position.x / _cellSize)),
+        static_cast<int>(std::floor(position.y / _cellSize)),
+        static_cast<int>(std::floor(position.z / _cellSize))
+    };
+}
+
+std::int64_t IntersectionCurve::getCellKey(const glm::ivec3 &cell)
+{
+    // distinct far cells may share key, distance test filters them out
+    const std::int64_t mask = (1 << 21) - 1;
+    return ((cell.x & mask) << 42) | ((cell.y & mask) << 21) | (cell.z & mask);
 }
 
 }
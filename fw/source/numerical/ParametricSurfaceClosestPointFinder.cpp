@@ -0,0 +1,240 @@
+#include "fw/numerical/ParametricSurfaceClosestPointFinder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace fw
+{
+
+ParametricSurfaceClosestPointFinder::ParametricSurfaceClosestPointFinder():
+    _referencePoint{},
+    _samplingResolution{24, 24},
+    _candidatesAmount{4},
+    _iterationLimit{32},
+    _tolerance{10e-10},
+    _wrapU{false},
+    _wrapV{false}
+{
+}
+
+ParametricSurfaceClosestPointFinder::~ParametricSurfaceClosestPointFinder()
+{
+}
+
+void ParametricSurfaceClosestPointFinder::setReferencePoint(
+    glm::dvec3 referencePoint
+)
+{
+    _referencePoint = referencePoint;
+}
+
+void ParametricSurfaceClosestPointFinder::setSamplingResolution(
+    glm::ivec2 samplingResolution
+)
+{
+    _samplingResolution = samplingResolution;
+}
+
+void ParametricSurfaceClosestPointFinder::setCandidatesAmount(
+    int candidatesAmount
+)
+{
+    _candidatesAmount = candidatesAmount;
+}
+
+void ParametricSurfaceClosestPointFinder::setIterationLimit(int iterationLimit)
+{
+    _iterationLimit = iterationLimit;
+}
+
+void ParametricSurfaceClosestPointFinder::setTolerance(double tolerance)
+{
+    _tolerance = tolerance;
+}
+
+void ParametricSurfaceClosestPointFinder::setDomainWrapping(
+    bool wrapU,
+    bool wrapV
+)
+{
+    _wrapU = wrapU;
+    _wrapV = wrapV;
+}
+
+glm::dvec2 ParametricSurfaceClosestPointFinder::find(
+    const IParametricSurfaceUV& surface
+) const
+{
+    // wrapped axes must not sample the same points twice at both ends
+    auto resolution = glm::dvec2(_samplingResolution);
+    glm::dvec2 maximumParameter{
+        _wrapU ? (resolution.x - 1.0) / resolution.x : 1.0,
+        _wrapV ? (resolution.y - 1.0) / resolution.y : 1.0
+    };
+
+    std::vector<glm::dvec3> positions;
+    surface.sampleGrid(
+        {0.0, 0.0},
+        maximumParameter,
+        _samplingResolution,
+        positions,
+        nullptr
+    );
+
+    auto numSamples = static_cast<int>(positions.size());
+    std::vector<double> distances(numSamples);
+    for (auto i = 0; i < numSamples; ++i)
+    {
+        distances[i] = glm::length(positions[i] - _referencePoint);
+    }
+
+    std::vector<int> candidates(positions.size());
+    std::iota(std::begin(candidates), std::end(candidates), 0);
+
+    auto candidatesAmount = std::min(
+        static_cast<int>(candidates.size()),
+        _candidatesAmount
+    );
+
+    std::partial_sort(
+        std::begin(candidates),
+        std::begin(candidates) + candidatesAmount,
+        std::end(candidates),
+        [&distances](int lhs, int rhs) {
+            return distances[lhs] < distances[rhs];
+        }
+    );
+
+    auto closestDistance = std::numeric_limits<double>::max();
+    glm::dvec2 closestPoint{};
+
+    for (auto i = 0; i < candidatesAmount; ++i)
+    {
+        auto sample = glm::ivec2{
+            candidates[i] % _samplingResolution.x,
+            candidates[i] / _samplingResolution.x
+        };
+
+        auto sampleParameters = glm::mix(
+            glm::dvec2{},
+            maximumParameter,
+            glm::dvec2(sample) / glm::max(resolution - 1.0, 1.0)
+        );
+
+        auto parameters = refine(surface, sampleParameters);
+        auto distance = glm::length(
+            surface.getPosition(parameters) - _referencePoint
+        );
+
+        if (distance < closestDistance)
+        {
+            closestDistance = distance;
+            closestPoint = parameters;
+        }
+    }
+
+    return closestPoint;
+}
+
+glm::dvec2 ParametricSurfaceClosestPointFinder::refine(
+    const IParametricSurfaceUV& surface,
+    glm::dvec2 parameters
+) const
+{
+    auto evaluation = surface.evaluate(parameters, 2);
+    auto difference = evaluation.position - _referencePoint;
+    auto squaredDistance = glm::dot(difference, difference);
+
+    for (auto iteration = 0; iteration < _iterationLimit; ++iteration)
+    {
+        const auto &su = evaluation.derivativeU;
+        const auto &sv = evaluation.derivativeV;
+
+        // gradient and hessian of 0.5 * |S(u,v) - P|^2
+        glm::dvec2 gradient{glm::dot(su, difference), glm::dot(sv, difference)};
+
+        auto huu = glm::dot(su, su)
+            + glm::dot(evaluation.derivativeUU, difference);
+        auto huv = glm::dot(su, sv)
+            + glm::dot(evaluation.derivativeUV, difference);
+        auto hvv = glm::dot(sv, sv)
+            + glm::dot(evaluation.derivativeVV, difference);
+        auto determinant = huu * hvv - huv * huv;
+
+        // far from the surface hessian may be indefinite, gauss-newton
+        // approximation is always positive semidefinite. It is also used
+        // when surface does not evaluate second derivatives (offsets).
+        if (evaluation.order < 2
+            || huu <= 0.0
+            || determinant <= std::numeric_limits<double>::epsilon())
+        {
+            huu = glm::dot(su, su);
+            huv = glm::dot(su, sv);
+            hvv = glm::dot(sv, sv);
+            determinant = huu * hvv - huv * huv;
+        }
+
+        if (std::abs(determinant) <= std::numeric_limits<double>::epsilon())
+        {
+            break;
+        }
+
+        glm::dvec2 step{
+            -(hvv * gradient.x - huv * gradient.y) / determinant,
+            -(huu * gradient.y - huv * gradient.x) / determinant
+        };
+
+        // backtracking keeps iterations from leaving current valley
+        auto accepted = false;
+        auto stepScale = 1.0;
+        glm::dvec2 nextParameters{};
+        SurfaceEvaluation nextEvaluation;
+
+        for (auto halving = 0; halving < 16 && !accepted; ++halving)
+        {
+            nextParameters = correctParameters(parameters + stepScale * step);
+            nextEvaluation = surface.evaluate(nextParameters, 2);
+            auto nextDifference = nextEvaluation.position - _referencePoint;
+            auto nextSquaredDistance = glm::dot(nextDifference, nextDifference);
+
+            if (nextSquaredDistance <= squaredDistance)
+            {
+                accepted = true;
+                difference = nextDifference;
+                squaredDistance = nextSquaredDistance;
+            }
+
+            stepScale *= 0.5;
+        }
+
+        if (!accepted) { break; }
+
+        auto parametersChange = glm::length(nextParameters - parameters);
+        parameters = nextParameters;
+        evaluation = nextEvaluation;
+
+        if (parametersChange < _tolerance) { break; }
+    }
+
+    return parameters;
+}
+
+glm::dvec2 ParametricSurfaceClosestPointFinder::correctParameters(
+    glm::dvec2 parameters
+) const
+{
+    parameters.x = _wrapU
+        ? parameters.x - std::floor(parameters.x)
+        : glm::clamp(parameters.x, 0.0, 1.0);
+
+    parameters.y = _wrapV
+        ? parameters.y - std::floor(parameters.y)
+        : glm::clamp(parameters.y, 0.0, 1.0);
+
+    return parameters;
+}
+
+}
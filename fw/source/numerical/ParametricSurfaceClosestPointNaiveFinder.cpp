@@ -1,5 +1,6 @@
 #include "fw/numerical/ParametricSurfaceClosestPointNaiveFinder.hpp"
 #include <limits>
+#include <vector>
 
 namespace fw
 {
@@ -34,14 +35,26 @@ glm::dvec2 ParametricSurfaceClosestPointNaiveFinder::
     double closestDistance = std::numeric_limits<double>::max();
     glm::dvec2 closestPoint{};
 
-    for (auto x = 0; x < _samplingResolution.x; ++x)
+    // samples are placed at x/resolution, excluding upper parameter bound
+    auto resolution = glm::dvec2(_samplingResolution);
+    auto maximumParameter = (resolution - 1.0) / resolution;
+
+    std::vector<glm::dvec3> positions;
+    surface.sampleGrid(
+        {0.0, 0.0},
+        maximumParameter,
+        _samplingResolution,
+        positions,
+        nullptr
+    );
+
+    for (auto y = 0; y < _samplingResolution.y; ++y)
     {
-        auto dx = x / static_cast<double>(_samplingResolution.x);
-        auto curve = surface.getConstParameterCurve(ParametrizationAxis::U, dx);
-        for (auto y = 0; y < _samplingResolution.y; ++y)
+        auto dy = y / static_cast<double>(_samplingResolution.y);
+        for (auto x = 0; x < _samplingResolution.x; ++x)
         {
-            auto dy = y / static_cast<double>(_samplingResolution.y);
-            auto position = curve->evaluate(dy);
+            auto dx = x / static_cast<double>(_samplingResolution.x);
+            const auto &position = positions[y * _samplingResolution.x + x];
             auto distance = glm::length(position - _referencePoint);
             if (distance < closestDistance)
             {
@@ -1,11 +1,77 @@
 #include "fw/numerical/ParametricSurfaceIntersectionFinder.hpp"
-#include "fw/numerical/ParametricSurfaceClosestPointNaiveFinder.hpp"
-#include <iostream>
+#include "fw/numerical/ParametricSurfaceClosestPointFinder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 namespace fw
 {
 
-ParametricSurfaceIntersectionFinder::ParametricSurfaceIntersectionFinder()
+namespace
+{
+
+// Successful iterations are rejected only for sharp turns, which remain
+// after the step is shrunk to minimum.
+IntersectionTracingStopReason getStopReason(
+    NewtonIterationExitStatus exitStatus
+)
+{
+    switch (exitStatus)
+    {
+    case NewtonIterationExitStatus::IterationLimitReached:
+        return IntersectionTracingStopReason::IterationLimitReached;
+    case NewtonIterationExitStatus::InvalidParameterReached:
+        return IntersectionTracingStopReason::InvalidParameterReached;
+    case NewtonIterationExitStatus::SingularJacobian:
+        return IntersectionTracingStopReason::SingularJacobian;
+    case NewtonIterationExitStatus::LineSearchFailed:
+        return IntersectionTracingStopReason::LineSearchFailed;
+    default:
+        return IntersectionTracingStopReason::MinimumStepReached;
+    }
+}
+
+bool isNearCurves(
+    const std::vector<std::vector<ParametricSurfaceIntersection>> &curves,
+    const AABB<glm::dvec3> &region,
+    int firstCurve = 0
+)
+{
+    auto numCurves = static_cast<int>(curves.size());
+    for (auto i = firstCurve; i < numCurves; ++i)
+    {
+        for (const auto &point: curves[i])
+        {
+            if (region.contains(point.scenePosition))
+            {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+}
+
+IntersectionTracingSettings::IntersectionTracingSettings():
+    initialStep{0.04},
+    minimumStep{0.001},
+    maximumStep{0.2},
+    stepGrowthFactor{1.5},
+    stepShrinkFactor{0.5},
+    maximumTurnAngle{0.2},
+    fastConvergenceIterations{3},
+    newtonIterationLimit{16},
+    convergenceThreshold{0.00001},
+    loopBackDistance{0.05},
+    stepLimit{2000}
+{
+}
+
+ParametricSurfaceIntersectionFinder::ParametricSurfaceIntersectionFinder():
+    _newtonSolvesCount{0},
+    _newtonIterationsCount{0}
 {
 }
 
@@ -13,42 +79,289 @@ ParametricSurfaceIntersectionFinder::~ParametricSurfaceIntersectionFinder()
 {
 }
 
+const IntersectionTracingSettings &
+        ParametricSurfaceIntersectionFinder::getTracingSettings() const
+{
+    return _settings;
+}
+
+void ParametricSurfaceIntersectionFinder::setTracingSettings(
+    const IntersectionTracingSettings &settings
+)
+{
+    _settings = settings;
+}
+
+int ParametricSurfaceIntersectionFinder::getNewtonSolvesCount() const
+{
+    return _newtonSolvesCount;
+}
+
+int ParametricSurfaceIntersectionFinder::getNewtonIterationsCount() const
+{
+    return _newtonIterationsCount;
+}
+
+const std::vector<IntersectionTracingStop> &
+        ParametricSurfaceIntersectionFinder::getTracingStops() const
+{
+    return _tracingStops;
+}
+
 std::vector<ParametricSurfaceIntersection>
         ParametricSurfaceIntersectionFinder::intersect(
     const std::shared_ptr<IParametricSurfaceUV> lhs,
     const std::shared_ptr<IParametricSurfaceUV> rhs,
     glm::vec3 neighbourhoodPoint
 )
+{
+    ParametricSurfaceClosestPointFinder closestPointFinder;
+    closestPointFinder.setReferencePoint(neighbourhoodPoint);
+
+    closestPointFinder.setDomainWrapping(
+        lhs->isPeriodic(ParametrizationAxis::U),
+        lhs->isPeriodic(ParametrizationAxis::V)
+    );
+    auto lhsClosest = closestPointFinder.find(*lhs);
+
+    closestPointFinder.setDomainWrapping(
+        rhs->isPeriodic(ParametrizationAxis::U),
+        rhs->isPeriodic(ParametrizationAxis::V)
+    );
+    auto rhsClosest = closestPointFinder.find(*rhs);
+
+    return trace(lhs, rhs, lhsClosest, rhsClosest);
+}
+
+std::vector<ParametricSurfaceIntersection>
+        ParametricSurfaceIntersectionFinder::trace(
+    const std::shared_ptr<IParametricSurfaceUV> lhs,
+    const std::shared_ptr<IParametricSurfaceUV> rhs,
+    glm::dvec2 lhsParameters,
+    glm::dvec2 rhsParameters
+)
 {
     // todo: parametric surface transformations should be taken into the account
     _intersectionCurve = IntersectionCurve();
+    _newtonSolvesCount = 0;
+    _newtonIterationsCount = 0;
     _lhs = lhs;
     _rhs = rhs;
 
-    ParametricSurfaceClosestPointNaiveFinder closestPointFinder;
-    closestPointFinder.setReferencePoint(neighbourhoodPoint);
-    closestPointFinder.setSamplingResolution({512, 512});
-    auto lhsClosest = closestPointFinder.find(*lhs);
-    auto rhsClosest = closestPointFinder.find(*rhs);
-
-    _newtonIterable.setCovergenceThreshold(0.00001);
-    _newtonIterable.setPlaneDistance(0.04);
+    _newtonIterator.setIterationLimit(_settings.newtonIterationLimit);
+    _newtonIterable.setCovergenceThreshold(_settings.convergenceThreshold);
     _newtonIterable.setSurfaces(lhs, rhs);
 
+    // steps are long on flat regions, so closing point may be only few
+    // indices away from the start, while short steps of tight turns keep
+    // many recent points in range, closing is decided by arc length
     _intersectionCurve.setLooping(true);
-    _intersectionCurve.setLoopbackMinimumIndexDifference(20);
-    _intersectionCurve.setLoopBackDistance(0.05);
+    _intersectionCurve.setLoopbackMinimumIndexDifference(4);
+    _intersectionCurve.setLoopBackDistance(_settings.loopBackDistance);
+    _intersectionCurve.setLoopBackMinimumArcLength(
+        2.0 * _settings.loopBackDistance
+    );
 
-    if (!iterateInDirection(1.0, lhsClosest, rhsClosest))
+    IntersectionTracingStop stop{
+        iterateInDirection(1.0, lhsParameters, rhsParameters),
+        IntersectionTracingStopReason::LoopClosed
+    };
+
+    if (stop.forward != IntersectionTracingStopReason::LoopClosed)
     {
         _intersectionCurve.reverse();
-        iterateInDirection(-1.0, lhsClosest, rhsClosest);
+        stop.backward = iterateInDirection(-1.0, lhsParameters, rhsParameters);
     }
 
+    _tracingStops = {stop};
+
     return _intersectionCurve.getCurvePoints();
 }
 
-bool ParametricSurfaceIntersectionFinder::iterateInDirection(
+std::vector<std::vector<ParametricSurfaceIntersection>>
+        ParametricSurfaceIntersectionFinder::intersect(
+    const std::shared_ptr<IParametricSurfaceUV> lhs,
+    const std::shared_ptr<IParametricSurfaceUV> rhs,
+    const std::vector<AABB<glm::dvec3>> &seedRegions
+)
+{
+    std::vector<std::vector<ParametricSurfaceIntersection>> curves;
+    std::vector<IntersectionTracingStop> tracingStops;
+    auto newtonSolvesCount = 0;
+    auto newtonIterationsCount = 0;
+    glm::dvec3 padding{
+        _settings.maximumStep,
+        _settings.maximumStep,
+        _settings.maximumStep
+    };
+
+    for (const auto &seedRegion: seedRegions)
+    {
+        AABB<glm::dvec3> paddedRegion{
+            seedRegion.min - padding,
+            seedRegion.max + padding
+        };
+
+        if (isNearCurves(curves, paddedRegion))
+        {
+            continue;
+        }
+
+        auto curve = intersect(
+            lhs,
+            rhs,
+            glm::vec3(0.5 * (seedRegion.min + seedRegion.max))
+        );
+
+        newtonSolvesCount += _newtonSolvesCount;
+        newtonIterationsCount += _newtonIterationsCount;
+
+        if (curve.empty())
+        {
+            continue;
+        }
+
+        // seed region may be reached by curve traced from other region
+        auto firstPoint = curve.front().scenePosition;
+        AABB<glm::dvec3> firstPointRegion{
+            firstPoint - 2.0 * padding,
+            firstPoint + 2.0 * padding
+        };
+
+        if (!isNearCurves(curves, firstPointRegion))
+        {
+            curves.push_back(curve);
+            tracingStops.push_back(_tracingStops.front());
+        }
+    }
+
+    _newtonSolvesCount = newtonSolvesCount;
+    _newtonIterationsCount = newtonIterationsCount;
+    _tracingStops = tracingStops;
+    return curves;
+}
+
+std::vector<std::vector<ParametricSurfaceIntersection>>
+        ParametricSurfaceIntersectionFinder::intersect(
+    const std::shared_ptr<IParametricSurfaceUV> lhs,
+    const std::shared_ptr<IParametricSurfaceUV> rhs,
+    const std::vector<IntersectionSeed> &seeds
+)
+{
+    std::vector<std::vector<ParametricSurfaceIntersection>> curves;
+    std::vector<IntersectionTracingStop> tracingStops;
+    auto newtonSolvesCount = 0;
+    auto newtonIterationsCount = 0;
+    glm::dvec3 padding{
+        _settings.maximumStep,
+        _settings.maximumStep,
+        _settings.maximumStep
+    };
+
+    // curve never leaves merged region of its seed, so only curves traced
+    // from the current region may be duplicated
+    auto firstRegionCurve = 0;
+    auto numSeeds = static_cast<int>(seeds.size());
+    for (auto i = 0; i < numSeeds; ++i)
+    {
+        const auto &seed = seeds[i];
+        if (i > 0 && seed.region != seeds[i - 1].region)
+        {
+            firstRegionCurve = static_cast<int>(curves.size());
+        }
+
+        if (isNearCurves(curves, seed.overlap, firstRegionCurve))
+        {
+            continue;
+        }
+
+        // bounds of patches are conservative, so seed is moved onto the
+        // intersection first and dropped when it lands on traced curve
+        glm::dvec4 parameters{seed.lhsParameters, seed.rhsParameters};
+        _newtonSolvesCount = 0;
+        _newtonIterationsCount = 0;
+        auto isOnIntersection = findNearestIntersection(lhs, rhs, parameters);
+        newtonSolvesCount += _newtonSolvesCount;
+        newtonIterationsCount += _newtonIterationsCount;
+
+        if (!isOnIntersection)
+        {
+            continue;
+        }
+
+        auto position = lhs->getPosition({parameters.x, parameters.y});
+        AABB<glm::dvec3> neighbourhood{
+            position - padding,
+            position + padding
+        };
+
+        if (isNearCurves(curves, neighbourhood, firstRegionCurve))
+        {
+            continue;
+        }
+
+        auto curve = trace(
+            lhs,
+            rhs,
+            {parameters.x, parameters.y},
+            {parameters.z, parameters.w}
+        );
+
+        newtonSolvesCount += _newtonSolvesCount;
+        newtonIterationsCount += _newtonIterationsCount;
+
+        if (!curve.empty())
+        {
+            curves.push_back(curve);
+            tracingStops.push_back(_tracingStops.front());
+        }
+    }
+
+    _newtonSolvesCount = newtonSolvesCount;
+    _newtonIterationsCount = newtonIterationsCount;
+    _tracingStops = tracingStops;
+    return curves;
+}
+
+bool ParametricSurfaceIntersectionFinder::findNearestIntersection(
+    const std::shared_ptr<IParametricSurfaceUV> lhs,
+    const std::shared_ptr<IParametricSurfaceUV> rhs,
+    glm::dvec4 &parameters
+)
+{
+    auto tangent = glm::cross(
+        lhs->getNormal({parameters.x, parameters.y}),
+        rhs->getNormal({parameters.z, parameters.w})
+    );
+
+    if (glm::length(tangent) < 10e-12)
+    {
+        return false;
+    }
+
+    // zero plane distance keeps solution in plane through lhs point
+    // perpendicular to tangent estimate
+    _newtonIterator.setIterationLimit(_settings.newtonIterationLimit);
+    _newtonIterable.setCovergenceThreshold(_settings.convergenceThreshold);
+    _newtonIterable.setSurfaces(lhs, rhs);
+    _newtonIterable.setTangentVector(tangent);
+    _newtonIterable.setPlaneDistance(0.0);
+
+    auto result = _newtonIterator.iterate(_newtonIterable, parameters);
+    ++_newtonSolvesCount;
+    _newtonIterationsCount += result.iterations;
+
+    if (result.exitStatus != NewtonIterationExitStatus::Success)
+    {
+        return false;
+    }
+
+    parameters = result.parameters;
+    return true;
+}
+
+IntersectionTracingStopReason
+        ParametricSurfaceIntersectionFinder::iterateInDirection(
     double tangentMultipler,
     glm::dvec2 initialLhsParams,
     glm::dvec2 initialRhsParams
@@ -56,42 +369,75 @@ bool ParametricSurfaceIntersectionFinder::iterateInDirection(
 {
     auto currentLhsParams = initialLhsParams;
     auto currentRhsParams = initialRhsParams;
+    auto step = _settings.initialStep;
 
-    for (int i = 0; i < 500; ++i)
+    for (int i = 0; i < _settings.stepLimit; ++i)
     {
-        auto lhsNormal = _lhs->getNormal(currentLhsParams);
-        auto rhsNormal = _rhs->getNormal(currentRhsParams);
-        auto currentTangent = glm::cross(lhsNormal, rhsNormal);
+        auto currentTangent = glm::cross(
+            _lhs->getNormal(currentLhsParams),
+            _rhs->getNormal(currentRhsParams)
+        );
 
-        _newtonIterable.setTangentVector(tangentMultipler * currentTangent);
+        if (glm::length(currentTangent) < 10e-12)
+        {
+            return IntersectionTracingStopReason::SurfacesTangent;
+        }
 
-        // todo: check if intersection is valid
-        auto intersectionResult = _newtonIterator.iterate(
-            _newtonIterable,
-            glm::dvec4{currentLhsParams, currentRhsParams}
-        );
+        currentTangent = tangentMultipler * glm::normalize(currentTangent);
+        _newtonIterable.setTangentVector(currentTangent);
+
+        NewtonIterationResult<glm::dvec4> intersectionResult;
+        glm::dvec3 nextTangent{};
+        auto accepted = false;
 
-        if (intersectionResult.exitStatus != NewtonIterationExitStatus::Success)
+        while (!accepted)
         {
-            std::string stopReasonText;
-            switch(intersectionResult.exitStatus)
+            _newtonIterable.setPlaneDistance(step);
+            intersectionResult = _newtonIterator.iterate(
+                _newtonIterable,
+                glm::dvec4{currentLhsParams, currentRhsParams}
+            );
+            ++_newtonSolvesCount;
+            _newtonIterationsCount += intersectionResult.iterations;
+
+            // failed iterations are treated like infinitely sharp turns
+            auto turnAngle = std::numeric_limits<double>::infinity();
+            if (intersectionResult.exitStatus
+                    == NewtonIterationExitStatus::Success)
             {
-            case NewtonIterationExitStatus::IterationLimitReached:
-                stopReasonText = "Iteration limit reached.";
-                break;
-            case NewtonIterationExitStatus::InvalidParameterReached:
-                stopReasonText = "Invalid parametrization reached.";
-                break;
-            default:
-                break;
+                const auto &parameters = intersectionResult.parameters;
+                nextTangent = glm::cross(
+                    _lhs->getNormal({parameters.x, parameters.y}),
+                    _rhs->getNormal({parameters.z, parameters.w})
+                );
+
+                auto tangentLength = glm::length(nextTangent);
+                if (tangentLength > 0.0)
+                {
+                    auto cosine = glm::dot(
+                        currentTangent,
+                        tangentMultipler * nextTangent / tangentLength
+                    );
+
+                    turnAngle = std::acos(glm::clamp(cosine, -1.0, 1.0));
+                }
             }
-            std::cout << "Stopping, reason: " << stopReasonText << std::endl;
 
-            if (intersectionResult.exitStatus
-                    == NewtonIterationExitStatus::InvalidParameterReached)
+            accepted = turnAngle <= _settings.maximumTurnAngle;
+            if (accepted || step <= _settings.minimumStep)
             {
                 break;
             }
+
+            step = std::max(
+                _settings.minimumStep,
+                step * _settings.stepShrinkFactor
+            );
+        }
+
+        if (!accepted)
+        {
+            return getStopReason(intersectionResult.exitStatus);
         }
 
         auto intersectionParameters = intersectionResult.parameters;
@@ -102,6 +448,12 @@ bool ParametricSurfaceIntersectionFinder::iterateInDirection(
         currentLhsParams = {intersectionParameters.x, intersectionParameters.y};
         currentRhsParams = {intersectionParameters.z, intersectionParameters.w};
 
+        // with long steps start point may be passed further than default
+        // loop back distance
+        auto loopBackDistance = std::max(_settings.loopBackDistance, step);
+        _intersectionCurve.setLoopBackDistance(loopBackDistance);
+        _intersectionCurve.setLoopBackMinimumArcLength(2.0 * loopBackDistance);
+
         auto addingResult = _intersectionCurve.addCurvePoint({
             currentLhsParams,
             currentRhsParams,
@@ -110,12 +462,26 @@ bool ParametricSurfaceIntersectionFinder::iterateInDirection(
 
         if (addingResult == IntersectionCurveAddingResult::LoopedBack)
         {
-            return true;
+            return IntersectionTracingStopReason::LoopClosed;
+        }
+
+        auto fastConvergence = intersectionResult.iterations
+            <= _settings.fastConvergenceIterations;
+        auto smallTurn = glm::dot(
+            currentTangent,
+            tangentMultipler * glm::normalize(nextTangent)
+        ) >= std::cos(0.5 * _settings.maximumTurnAngle);
+
+        if (fastConvergence && smallTurn)
+        {
+            step = std::min(
+                _settings.maximumStep,
+                step * _settings.stepGrowthFactor
+            );
         }
     }
 
-    return false;
+    return IntersectionTracingStopReason::StepLimitReached;
 }
 
 }
-
@@ -0,0 +1,267 @@
+#include "fw/numerical/ParametricSurfaceLodChain.hpp"
+#include "fw/numerical/ParametricSurfaceMeshBuilder.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+
+namespace fw
+{
+
+namespace
+{
+
+const glm::ivec2 BoundsSamplingResolution{16, 16};
+
+bool isReady(const std::future<void> &future)
+{
+    return future.valid() && future.wait_for(std::chrono::seconds{0})
+        == std::future_status::ready;
+}
+
+}
+
+ParametricSurfaceLodChain::ParametricSurfaceLodChain(
+    std::shared_ptr<IParametricSurfaceUV> surface,
+    std::vector<glm::ivec2> resolutions,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter
+):
+    _surface{surface},
+    _minimumParameter{minimumParameter},
+    _maximumParameter{maximumParameter},
+    _pixelsPerSample{4.0},
+    _levels(resolutions.size())
+{
+    assert(!resolutions.empty());
+
+    auto numLevels = static_cast<int>(resolutions.size());
+    for (auto i = 0; i < numLevels; ++i)
+    {
+        _levels[i].resolution = resolutions[i];
+        _levels[i].requested = false;
+    }
+
+    std::vector<glm::dvec3> positions;
+    _surface->sampleGrid(
+        _minimumParameter,
+        _maximumParameter,
+        BoundsSamplingResolution,
+        positions,
+        nullptr
+    );
+
+    _bounds = {positions.front(), positions.front()};
+    for (const auto &position: positions)
+    {
+        _bounds.min = glm::min(_bounds.min, position);
+        _bounds.max = glm::max(_bounds.max, position);
+    }
+}
+
+ParametricSurfaceLodChain::~ParametricSurfaceLodChain()
+{
+    // tasks write into levels, they have to finish first
+    for (const auto &level: _levels)
+    {
+        if (level.building.valid())
+        {
+            level.building.wait();
+        }
+    }
+}
+
+void ParametricSurfaceLodChain::setThreadPool(
+    std::shared_ptr<ThreadPool> threadPool
+)
+{
+    _threadPool = threadPool;
+}
+
+std::shared_ptr<ThreadPool> ParametricSurfaceLodChain::getThreadPool() const
+{
+    return _threadPool;
+}
+
+void ParametricSurfaceLodChain::setPixelsPerSample(double pixelsPerSample)
+{
+    _pixelsPerSample = pixelsPerSample;
+}
+
+double ParametricSurfaceLodChain::getPixelsPerSample() const
+{
+    return _pixelsPerSample;
+}
+
+int ParametricSurfaceLodChain::getNumLevels() const
+{
+    return static_cast<int>(_levels.size());
+}
+
+glm::ivec2 ParametricSurfaceLodChain::getResolution(int level) const
+{
+    return _levels[level].resolution;
+}
+
+const AABB<glm::dvec3> &ParametricSurfaceLodChain::getBounds() const
+{
+    return _bounds;
+}
+
+int ParametricSurfaceLodChain::selectLevel(
+    const glm::mat4 &modelViewProjection,
+    glm::ivec2 viewportSize
+) const
+{
+    const auto numCorners = 8;
+    auto finestLevel = getNumLevels() - 1;
+    auto numCornersBehind = 0;
+    glm::vec2 screenMinimum{}, screenMaximum{};
+
+    for (auto corner = 0; corner < numCorners; ++corner)
+    {
+        glm::vec3 point{
+            corner & 1 ? _bounds.max.x : _bounds.min.x,
+            corner & 2 ? _bounds.max.y : _bounds.min.y,
+            corner & 4 ? _bounds.max.z : _bounds.min.z
+        };
+
+        auto clip = modelViewProjection * glm::vec4{point, 1.0f};
+        if (clip.w <= 0.0f)
+        {
+            ++numCornersBehind;
+            continue;
+        }
+
+        auto screen = (0.5f * glm::vec2{clip} / clip.w + 0.5f)
+            * glm::vec2{viewportSize};
+
+        auto isFirst = corner == numCornersBehind;
+        screenMinimum = isFirst ? screen : glm::min(screenMinimum, screen);
+        screenMaximum = isFirst ? screen : glm::max(screenMaximum, screen);
+    }
+
+    // surface behind the eye is not visible, while bounds crossing the
+    // plane of the eye have no finite projection
+    if (numCornersBehind == numCorners)
+    {
+        return 0;
+    }
+
+    if (numCornersBehind > 0)
+    {
+        return finestLevel;
+    }
+
+    auto extent = screenMaximum - screenMinimum;
+    auto requiredSamples = std::max(extent.x, extent.y) / _pixelsPerSample;
+
+    for (auto i = 0; i < finestLevel; ++i)
+    {
+        auto resolution = _levels[i].resolution;
+        if (std::max(resolution.x, resolution.y) >= requiredSamples)
+        {
+            return i;
+        }
+    }
+
+    return finestLevel;
+}
+
+void ParametricSurfaceLodChain::requestLevel(int level)
+{
+    auto &requestedLevel = _levels[level];
+    if (requestedLevel.requested)
+    {
+        return;
+    }
+
+    requestedLevel.requested = true;
+    if (_threadPool != nullptr)
+    {
+        requestedLevel.building = _threadPool->enqueue(
+            [this, &requestedLevel]() { buildLevel(requestedLevel); }
+        );
+    }
+    else
+    {
+        std::promise<void> built;
+        buildLevel(requestedLevel);
+        built.set_value();
+        requestedLevel.building = built.get_future();
+    }
+}
+
+bool ParametricSurfaceLodChain::isLevelBuilt(int level) const
+{
+    return isReady(_levels[level].building);
+}
+
+void ParametricSurfaceLodChain::waitForLevel(int level) const
+{
+    if (_levels[level].building.valid())
+    {
+        _levels[level].building.wait();
+    }
+}
+
+std::shared_ptr<Mesh<VertexNormalTexCoords>>
+        ParametricSurfaceLodChain::getMesh(int level)
+{
+    requestLevel(level);
+    createMeshes();
+
+    if (_levels[level].mesh != nullptr)
+    {
+        return _levels[level].mesh;
+    }
+
+    for (auto distance = 1; distance < getNumLevels(); ++distance)
+    {
+        for (auto candidate: {level - distance, level + distance})
+        {
+            if (candidate >= 0 && candidate < getNumLevels()
+                && _levels[candidate].mesh != nullptr)
+            {
+                return _levels[candidate].mesh;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
+void ParametricSurfaceLodChain::buildLevel(Level &level) const
+{
+    ParametricSurfaceMeshBuilder builder;
+    builder.setSamplingResolution(level.resolution);
+    builder.buildGeometry(
+        *_surface,
+        level.vertices,
+        level.indices,
+        _minimumParameter,
+        _maximumParameter
+    );
+}
+
+void ParametricSurfaceLodChain::createMeshes()
+{
+    for (auto &level: _levels)
+    {
+        if (level.mesh != nullptr || !isReady(level.building))
+        {
+            continue;
+        }
+
+        level.mesh = std::make_shared<Mesh<VertexNormalTexCoords>>(
+            level.vertices,
+            level.indices
+        );
+
+        // geometry lives in GL buffers from now on
+        std::vector<VertexNormalTexCoords>{}.swap(level.vertices);
+        std::vector<GLuint>{}.swap(level.indices);
+    }
+}
+
+}
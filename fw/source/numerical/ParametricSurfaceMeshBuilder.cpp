@@ -3,6 +3,8 @@
 #include "Mesh.hpp"
 #include "Vertices.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -11,6 +13,44 @@
 namespace fw
 {
 
+namespace
+{
+
+// Inclusive range of grid samples with parameters inside given range,
+// rounded outwards so that samples lying on range bounds are included.
+glm::ivec2 getSampleRange(
+    double minimumParameter,
+    double maximumParameter,
+    double rangeBegin,
+    double rangeEnd,
+    int resolution
+)
+{
+    auto extent = maximumParameter - minimumParameter;
+    if (resolution <= 1 || extent == 0.0)
+    {
+        auto contained = rangeBegin <= minimumParameter
+            && minimumParameter <= rangeEnd;
+        return contained ? glm::ivec2{0, 0} : glm::ivec2{0, -1};
+    }
+
+    auto scale = (resolution - 1) / extent;
+    auto first = std::floor((rangeBegin - minimumParameter) * scale);
+    auto last = std::ceil((rangeEnd - minimumParameter) * scale);
+
+    if (last < 0.0 || first > resolution - 1)
+    {
+        return {0, -1};
+    }
+
+    return {
+        std::max(0, static_cast<int>(first)),
+        std::min(resolution - 1, static_cast<int>(last))
+    };
+}
+
+}
+
 ParametricSurfaceMeshBuilder::ParametricSurfaceMeshBuilder()
 {
 }
@@ -31,55 +71,285 @@ glm::ivec2 ParametricSurfaceMeshBuilder::getSamplingResolution() const
     return _samplingResolution;
 }
 
+void ParametricSurfaceMeshBuilder::setThreadPool(
+    std::shared_ptr<ThreadPool> threadPool
+)
+{
+    _threadPool = threadPool;
+}
+
+std::shared_ptr<ThreadPool> ParametricSurfaceMeshBuilder::getThreadPool() const
+{
+    return _threadPool;
+}
+
 std::shared_ptr<Mesh<VertexNormalTexCoords>>
         ParametricSurfaceMeshBuilder::build(
     std::shared_ptr<IParametricSurfaceUV> surface,
     glm::dvec2 minimumParameter,
-    glm::dvec2 maximumParameter
+    glm::dvec2 maximumParameter,
+    GLenum usage
 ) const
 {
     std::vector<VertexNormalTexCoords> vertices;
     std::vector<GLuint> indices;
 
-    vertices.reserve(_samplingResolution.x * _samplingResolution.y);
+    buildGeometry(
+        *surface,
+        vertices,
+        indices,
+        minimumParameter,
+        maximumParameter
+    );
 
-    for (auto y = 0; y < _samplingResolution.y; ++y)
+    return std::make_shared<Mesh<VertexNormalTexCoords>>(
+        vertices,
+        indices,
+        GL_TRIANGLES,
+        usage
+    );
+}
+
+void ParametricSurfaceMeshBuilder::buildGeometry(
+    const IParametricSurfaceUV &surface,
+    std::vector<VertexNormalTexCoords> &vertices,
+    std::vector<GLuint> &indices,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter
+) const
+{
+    auto numQuads = std::max(0, _samplingResolution.x - 1)
+        * std::max(0, _samplingResolution.y - 1);
+
+    vertices.resize(_samplingResolution.x * _samplingResolution.y);
+    indices.resize(6 * numQuads);
+
+    auto buildRowRange = [&](int firstRow, int lastRow) {
+        buildRows(
+            surface,
+            minimumParameter,
+            maximumParameter,
+            firstRow,
+            lastRow,
+            vertices,
+            indices
+        );
+    };
+
+    if (_threadPool != nullptr && _threadPool->getNumThreads() > 1)
+    {
+        _threadPool->parallelFor(0, _samplingResolution.y, buildRowRange);
+    }
+    else
+    {
+        buildRowRange(0, _samplingResolution.y);
+    }
+}
+
+AABB<glm::ivec2> ParametricSurfaceMeshBuilder::updateGeometry(
+    const IParametricSurfaceUV &surface,
+    const AABB<glm::dvec2> &changedRegion,
+    std::vector<VertexNormalTexCoords> &vertices,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter
+) const
+{
+    auto rangeU = getSampleRange(
+        minimumParameter.x,
+        maximumParameter.x,
+        changedRegion.min.x,
+        changedRegion.max.x,
+        _samplingResolution.x
+    );
+
+    auto rangeV = getSampleRange(
+        minimumParameter.y,
+        maximumParameter.y,
+        changedRegion.min.y,
+        changedRegion.max.y,
+        _samplingResolution.y
+    );
+
+    AABB<glm::ivec2> samples{
+        {rangeU.x, rangeV.x},
+        {rangeU.y, rangeV.y}
+    };
+
+    if (!samples.isValid())
+    {
+        return samples;
+    }
+
+    auto updateRowRange = [&](int firstRow, int lastRow) {
+        updateRows(
+            surface,
+            samples,
+            minimumParameter,
+            maximumParameter,
+            firstRow,
+            lastRow,
+            vertices
+        );
+    };
+
+    if (_threadPool != nullptr && _threadPool->getNumThreads() > 1)
+    {
+        _threadPool->parallelFor(
+            samples.min.y,
+            samples.max.y + 1,
+            updateRowRange
+        );
+    }
+    else
+    {
+        updateRowRange(samples.min.y, samples.max.y + 1);
+    }
+
+    return samples;
+}
+
+void ParametricSurfaceMeshBuilder::update(
+    const IParametricSurfaceUV &surface,
+    const AABB<glm::dvec2> &changedRegion,
+    std::vector<VertexNormalTexCoords> &vertices,
+    Mesh<VertexNormalTexCoords> &mesh,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter
+) const
+{
+    auto samples = updateGeometry(
+        surface,
+        changedRegion,
+        vertices,
+        minimumParameter,
+        maximumParameter
+    );
+
+    if (!samples.isValid())
+    {
+        return;
+    }
+
+    auto width = samples.max.x - samples.min.x + 1;
+    auto firstVertex = samples.min.y * _samplingResolution.x + samples.min.x;
+
+    // full rows are contiguous in vertex buffer and go in single upload
+    if (width == _samplingResolution.x)
+    {
+        auto numRows = samples.max.y - samples.min.y + 1;
+        mesh.updateVertices(
+            firstVertex,
+            numRows * width,
+            vertices.data() + firstVertex
+        );
+        return;
+    }
+
+    for (auto y = samples.min.y; y <= samples.max.y; ++y)
+    {
+        auto rowVertex = y * _samplingResolution.x + samples.min.x;
+        mesh.updateVertices(rowVertex, width, vertices.data() + rowVertex);
+    }
+}
+
+void ParametricSurfaceMeshBuilder::updateRows(
+    const IParametricSurfaceUV &surface,
+    const AABB<glm::ivec2> &samples,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter,
+    int firstRow,
+    int lastRow,
+    std::vector<VertexNormalTexCoords> &vertices
+) const
+{
+    // rows are sampled whole with the same grid as in buildRows, so every
+    // sample gets exactly the parameters of full rebuild and repeated
+    // updates do not drift from it, only changed columns are copied
+    auto numRows = lastRow - firstRow;
+    std::vector<glm::vec3> positions(numRows * _samplingResolution.x);
+    std::vector<glm::vec3> normals(numRows * _samplingResolution.x);
+
+    surface.sampleGridRowsSinglePrecision(
+        minimumParameter,
+        maximumParameter,
+        _samplingResolution,
+        firstRow,
+        numRows,
+        positions.data(),
+        normals.data()
+    );
+
+    for (auto y = firstRow; y < lastRow; ++y)
+    {
+        for (auto x = samples.min.x; x <= samples.max.x; ++x)
+        {
+            auto sampleIndex = (y - firstRow) * _samplingResolution.x + x;
+            auto &vertex = vertices[y * _samplingResolution.x + x];
+            vertex.position = positions[sampleIndex];
+            vertex.normal = normals[sampleIndex];
+        }
+    }
+}
+
+void ParametricSurfaceMeshBuilder::buildRows(
+    const IParametricSurfaceUV &surface,
+    glm::dvec2 minimumParameter,
+    glm::dvec2 maximumParameter,
+    int firstRow,
+    int lastRow,
+    std::vector<VertexNormalTexCoords> &vertices,
+    std::vector<GLuint> &indices
+) const
+{
+    auto numRows = lastRow - firstRow;
+    std::vector<glm::vec3> positions(numRows * _samplingResolution.x);
+    std::vector<glm::vec3> normals(numRows * _samplingResolution.x);
+
+    surface.sampleGridRowsSinglePrecision(
+        minimumParameter,
+        maximumParameter,
+        _samplingResolution,
+        firstRow,
+        numRows,
+        positions.data(),
+        normals.data()
+    );
+
+    for (auto y = firstRow; y < lastRow; ++y)
     {
         auto dy = static_cast<double>(y)/(_samplingResolution.y - 1);
         for (auto x = 0; x < _samplingResolution.x; ++x)
         {
             auto dx = static_cast<double>(x)/(_samplingResolution.x - 1);
-            glm::dvec2 dp { dx, dy };
-            glm::dvec2 parametrisation =
-                glm::mix(minimumParameter, maximumParameter, dp);
-
-            auto position = surface->getPosition(parametrisation);
-            auto normal = surface->getNormal(parametrisation);
-
-            vertices.push_back({
-                glm::vec3(position),
-                glm::vec3(normal),
-                glm::vec2(dp)
-            });
+            auto sampleIndex = (y - firstRow) * _samplingResolution.x + x;
+
+            vertices[y * _samplingResolution.x + x] = {
+                positions[sampleIndex],
+                normals[sampleIndex],
+                glm::vec2(dx, dy)
+            };
         }
     }
 
-    for (auto y = 0; y < _samplingResolution.y - 1; ++y)
+    // row y of quads joins vertex rows y and y+1
+    auto lastQuadRow = std::min(lastRow, _samplingResolution.y - 1);
+    for (auto y = firstRow; y < lastQuadRow; ++y)
     {
         for (auto x = 0; x < _samplingResolution.x - 1; ++x)
         {
             auto baseIndex = y * _samplingResolution.x + x;
-            indices.push_back(baseIndex);
-            indices.push_back(baseIndex+1);
-            indices.push_back(baseIndex+_samplingResolution.x);
+            auto output = indices.data()
+                + 6 * (y * (_samplingResolution.x - 1) + x);
 
-            indices.push_back(baseIndex+1);
-            indices.push_back(baseIndex+_samplingResolution.x);
-            indices.push_back(baseIndex+_samplingResolution.x+1);
+            output[0] = baseIndex;
+            output[1] = baseIndex+1;
+            output[2] = baseIndex+_samplingResolution.x;
+
+            output[3] = baseIndex+1;
+            output[4] = baseIndex+_samplingResolution.x;
+            output[5] = baseIndex+_samplingResolution.x+1;
         }
     }
-
-    return std::make_shared<Mesh<VertexNormalTexCoords>>(vertices, indices);
 }
 
 }
@@ -8,6 +8,7 @@ namespace fw
 {
 
 SurfaceIntersectionNewtonIterable::SurfaceIntersectionNewtonIterable():
+    _useNumericPlaneDerivatives{false},
     _covergenceThreshold{0.005}
 {
 }
@@ -28,6 +29,18 @@ void SurfaceIntersectionNewtonIterable::setTangentVector(
     _tangentVector = glm::normalize(tangentVector);
 }
 
+bool SurfaceIntersectionNewtonIterable::isUsingNumericPlaneDerivatives() const
+{
+    return _useNumericPlaneDerivatives;
+}
+
+void SurfaceIntersectionNewtonIterable::setUsingNumericPlaneDerivatives(
+    bool useNumericDerivatives
+)
+{
+    _useNumericPlaneDerivatives = useNumericDerivatives;
+}
+
 double SurfaceIntersectionNewtonIterable::getCovergenceThreshold() const
 {
     return _covergenceThreshold;
@@ -58,6 +71,10 @@ void SurfaceIntersectionNewtonIterable::setCurrentParameters(
 )
 {
     _parameters = parameters;
+
+    // both function value and jacobian are built from those evaluations
+    _lhsEvaluation = _lhsSurface->evaluate({parameters.x, parameters.y}, 1);
+    _rhsEvaluation = _rhsSurface->evaluate({parameters.z, parameters.w}, 1);
 }
 
 bool SurfaceIntersectionNewtonIterable::areParametersValid(
@@ -91,8 +108,8 @@ glm::dvec4 SurfaceIntersectionNewtonIterable::evaluateFunction() const
     // Equation system:
     //  P(u,v) - Q(s,t) = 0
     //  <P(u,v) - P0, t> - d = 0
-    auto lhsPosition = _lhsSurface->getPosition({_parameters.x, _parameters.y});
-    auto rhsPosition = _rhsSurface->getPosition({_parameters.z, _parameters.w});
+    const auto &lhsPosition = _lhsEvaluation.position;
+    const auto &rhsPosition = _rhsEvaluation.position;
     auto firstEquation = lhsPosition - rhsPosition;
     auto secondEquation = calculateTangentPlaneDistance(lhsPosition);
 
@@ -106,16 +123,13 @@ glm::dvec4 SurfaceIntersectionNewtonIterable::evaluateFunction() const
     return functionValue;
 }
 
-glm::dmat4 SurfaceIntersectionNewtonIterable::getJacobianInverse() const
+glm::dmat4 SurfaceIntersectionNewtonIterable::getJacobian() const
 {
-    glm::dvec2 lhsParam{_parameters.x, _parameters.y};
-    glm::dvec2 rhsParam{_parameters.z, _parameters.w};
+    const auto &lhsdU = _lhsEvaluation.derivativeU;
+    const auto &lhsdV = _lhsEvaluation.derivativeV;
 
-    auto lhsdU = _lhsSurface->getDerivativeU(lhsParam);
-    auto lhsdV = _lhsSurface->getDerivativeV(lhsParam);
-
-    auto rhsdU = _rhsSurface->getDerivativeU(rhsParam);
-    auto rhsdV = _rhsSurface->getDerivativeV(rhsParam);
+    const auto &rhsdU = _rhsEvaluation.derivativeU;
+    const auto &rhsdV = _rhsEvaluation.derivativeV;
 
     auto planeDerivatives = getTangentPlaneDerivatives();
 
@@ -126,7 +140,12 @@ glm::dmat4 SurfaceIntersectionNewtonIterable::getJacobianInverse() const
         { -rhsdV.x, -rhsdV.y, -rhsdV.z, planeDerivatives.w }  // dw
     };
 
-    return glm::inverse(jacobian);
+    return jacobian;
+}
+
+glm::dmat4 SurfaceIntersectionNewtonIterable::getJacobianInverse() const
+{
+    return glm::inverse(getJacobian());
 }
 
 glm::dvec4 SurfaceIntersectionNewtonIterable::correctParametrisation(
@@ -155,6 +174,23 @@ double SurfaceIntersectionNewtonIterable::calculateTangentPlaneDistance(
 }
 
 glm::dvec4 SurfaceIntersectionNewtonIterable::getTangentPlaneDerivatives() const
+{
+    if (_useNumericPlaneDerivatives)
+    {
+        return getNumericTangentPlaneDerivatives();
+    }
+
+    // plane constraint depends only on lhs position: <P(u,v) - P0, t> - d
+    return {
+        glm::dot(_lhsEvaluation.derivativeU, _tangentVector),
+        glm::dot(_lhsEvaluation.derivativeV, _tangentVector),
+        0,
+        0
+    };
+}
+
+glm::dvec4 SurfaceIntersectionNewtonIterable::
+        getNumericTangentPlaneDerivatives() const
 {
     const double dh = 10e-6;
     glm::dvec2 lhsParams{_parameters.x, _parameters.y};
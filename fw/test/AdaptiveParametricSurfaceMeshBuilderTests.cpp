@@ -0,0 +1,182 @@
+#include "fw/numerical/AdaptiveParametricSurfaceMeshBuilder.hpp"
+#include "fw/numerical/CommonBsplineSurfaces.hpp"
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <memory>
+#include <utility>
+
+class AdaptiveParametricSurfaceMeshBuilderTests:
+    public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        _plane = fw::createBsplinePlane(
+            {0.0, 0.0, 0.0},
+            {1.0, 0.0, 0.0},
+            {0.0, 0.0, 1.0},
+            {1.0, 0.0, 1.0},
+            glm::dmat4(),
+            {8, 8}
+        );
+
+        // plane with a bump close to single corner
+        auto controlPoints = _plane->getControlPoints();
+        controlPoints[8 * 1 + 1].y = 0.5;
+        _bumpedPlane = std::make_shared<fw::BsplineSurface>(
+            _plane->getDegree(),
+            glm::ivec2{8, 8},
+            controlPoints,
+            _plane->getKnotsOnU(),
+            _plane->getKnotsOnV()
+        );
+
+        const auto &knots = _plane->getKnotsOnU();
+        _minimumParameter = glm::dvec2{knots[3]};
+        _maximumParameter = glm::dvec2{knots[8]};
+
+        fw::AdaptiveTessellationSettings settings;
+        settings.initialResolution = {4, 4};
+        settings.maximumDepth = 6;
+        settings.chordHeightTolerance = 0.001;
+        _builder.setSettings(settings);
+    }
+
+    virtual void TearDown() override
+    {
+    }
+
+protected:
+    // Every edge inside the domain has to be shared by two triangles, so
+    // there are no T-junctions or cracks.
+    void expectWatertight(
+        const std::vector<fw::VertexNormalTexCoords> &vertices,
+        const std::vector<GLuint> &indices
+    ) const
+    {
+        std::map<std::pair<GLuint, GLuint>, int> edges;
+        for (auto i = 0; i < indices.size(); i += 3)
+        {
+            for (auto k = 0; k < 3; ++k)
+            {
+                auto a = indices[i + k], b = indices[i + (k + 1) % 3];
+                ++edges[{std::min(a, b), std::max(a, b)}];
+            }
+        }
+
+        for (const auto &edge: edges)
+        {
+            auto lhs = vertices[edge.first.first].texCoords;
+            auto rhs = vertices[edge.first.second].texCoords;
+            auto onBoundary = (lhs.x == rhs.x && (lhs.x == 0 || lhs.x == 1))
+                || (lhs.y == rhs.y && (lhs.y == 0 || lhs.y == 1));
+
+            EXPECT_EQ(onBoundary ? 1 : 2, edge.second);
+        }
+    }
+
+    std::shared_ptr<fw::BsplineSurface> _plane;
+    std::shared_ptr<fw::BsplineSurface> _bumpedPlane;
+    glm::dvec2 _minimumParameter;
+    glm::dvec2 _maximumParameter;
+    fw::AdaptiveParametricSurfaceMeshBuilder _builder;
+};
+
+TEST_F(AdaptiveParametricSurfaceMeshBuilderTests, ShouldNotRefineFlatSurface)
+{
+    std::vector<fw::VertexNormalTexCoords> vertices;
+    std::vector<GLuint> indices;
+    _builder.buildGeometry(
+        *_plane,
+        vertices,
+        indices,
+        _minimumParameter,
+        _maximumParameter
+    );
+
+    EXPECT_EQ(5 * 5, vertices.size());
+    EXPECT_EQ(6 * 4 * 4, indices.size());
+    expectWatertight(vertices, indices);
+}
+
+TEST_F(AdaptiveParametricSurfaceMeshBuilderTests, ShouldRefineOnlyCurvedRegion)
+{
+    std::vector<fw::VertexNormalTexCoords> vertices;
+    std::vector<GLuint> indices;
+    _builder.buildGeometry(
+        *_bumpedPlane,
+        vertices,
+        indices,
+        _minimumParameter,
+        _maximumParameter
+    );
+
+    expectWatertight(vertices, indices);
+
+    // bump is supported by lower left part of the domain only
+    auto numTrianglesNearBump = 0;
+    for (auto i = 0; i < indices.size(); i += 3)
+    {
+        auto texCoords = vertices[indices[i]].texCoords;
+        if (texCoords.x < 0.5 && texCoords.y < 0.5)
+        {
+            ++numTrianglesNearBump;
+        }
+    }
+
+    auto numTriangles = static_cast<int>(indices.size() / 3);
+    EXPECT_GT(numTriangles, 2 * 4 * 4);
+    EXPECT_GT(numTrianglesNearBump, numTriangles * 3 / 4);
+
+    for (const auto &vertex: vertices)
+    {
+        auto parameter = glm::mix(
+            _minimumParameter,
+            _maximumParameter,
+            glm::dvec2(vertex.texCoords)
+        );
+
+        auto expected = glm::vec3(_bumpedPlane->getPosition(parameter));
+        EXPECT_NEAR(0.0, glm::length(expected - vertex.position), 1e-5);
+    }
+}
+
+TEST_F(AdaptiveParametricSurfaceMeshBuilderTests,
+    ShouldRefineLessFarFromEyeWithScreenSpaceError)
+{
+    auto settings = _builder.getSettings();
+    settings.useScreenSpaceError = true;
+    settings.projectionScale = 1000.0;
+    settings.screenSpaceTolerance = 1.0;
+
+    std::vector<fw::VertexNormalTexCoords> vertices;
+    std::vector<GLuint> nearIndices, farIndices;
+
+    settings.eyePosition = {0.2, 1.0, 0.2};
+    _builder.setSettings(settings);
+    _builder.buildGeometry(
+        *_bumpedPlane,
+        vertices,
+        nearIndices,
+        _minimumParameter,
+        _maximumParameter
+    );
+
+    expectWatertight(vertices, nearIndices);
+
+    settings.eyePosition = {0.2, 100.0, 0.2};
+    _builder.setSettings(settings);
+    _builder.buildGeometry(
+        *_bumpedPlane,
+        vertices,
+        farIndices,
+        _minimumParameter,
+        _maximumParameter
+    );
+
+    expectWatertight(vertices, farIndices);
+    EXPECT_LT(farIndices.size(), nearIndices.size());
+}
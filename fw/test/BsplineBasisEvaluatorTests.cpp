@@ -100,3 +100,122 @@ TEST_F(BsplineBasisEvaluatorTests, ShouldEvaluateCorrectSecondDegreeBasis)
         EXPECT_THAT(basis, ElementsAre(0.0));
     }
 }
+
+TEST_F(BsplineBasisEvaluatorTests, ShouldFindKnotSpanOfParameter)
+{
+    prepareDegree(1);
+
+    EXPECT_EQ(0, _evaluator->findKnotSpan(0.0));
+    EXPECT_EQ(1, _evaluator->findKnotSpan(1.5));
+    EXPECT_EQ(2, _evaluator->findKnotSpan(2.0));
+    EXPECT_EQ(-1, _evaluator->findKnotSpan(3.0));
+    EXPECT_EQ(-1, _evaluator->findKnotSpan(-0.5));
+}
+
+TEST_F(
+    BsplineBasisEvaluatorTests,
+    ShouldEvaluateNonVanishingBasisConsistentWithFullBasis
+)
+{
+    std::vector<double> knots {
+        0.0, 0.0, 0.1, 0.2, 0.2, 0.45, 0.6, 0.7, 0.85, 1.0, 1.0
+    };
+
+    for (auto degree = 0; degree <= 3; ++degree)
+    {
+        fw::BsplineBasisEvaluator evaluator{degree, knots};
+        std::vector<double> localBasis(evaluator.getSupportSize());
+
+        for (auto parameter = 0.0; parameter < 1.0; parameter += 0.01)
+        {
+            auto fullBasis = evaluator.evaluate(parameter);
+            auto span = evaluator.evaluateNonVanishing(
+                parameter,
+                localBasis.data()
+            );
+
+            ASSERT_EQ(evaluator.findKnotSpan(parameter), span);
+
+            for (auto i = 0; i < fullBasis.size(); ++i)
+            {
+                auto localIndex = i - (span - degree);
+                auto expected = 0 <= localIndex && localIndex <= degree
+                    ? localBasis[localIndex]
+                    : 0.0;
+                EXPECT_DOUBLE_EQ(expected, fullBasis[i]);
+            }
+        }
+    }
+}
+
+TEST_F(
+    BsplineBasisEvaluatorTests,
+    ShouldEvaluateNonVanishingDerivativesMatchingFiniteDifferences
+)
+{
+    std::vector<double> knots {
+        0.0, 0.05, 0.1, 0.2, 0.3, 0.45, 0.6, 0.7, 0.85, 0.9, 1.0
+    };
+
+    const int degree = 3;
+    const int order = 2;
+    const double h = 1e-5;
+
+    fw::BsplineBasisEvaluator evaluator{degree, knots};
+    std::vector<double> derivatives((order + 1) * (degree + 1));
+    std::vector<double> previous(degree + 1), next(degree + 1);
+
+    for (auto parameter = 0.325; parameter < 0.58; parameter += 0.01)
+    {
+        auto span = evaluator.evaluateNonVanishingDerivatives(
+            parameter,
+            order,
+            derivatives.data()
+        );
+
+        ASSERT_EQ(span, evaluator.evaluateNonVanishing(parameter - h,
+            previous.data()));
+        ASSERT_EQ(span, evaluator.evaluateNonVanishing(parameter + h,
+            next.data()));
+
+        for (auto i = 0; i <= degree; ++i)
+        {
+            auto value = derivatives[i];
+            auto firstDerivative = derivatives[(degree + 1) + i];
+            auto secondDerivative = derivatives[2 * (degree + 1) + i];
+
+            EXPECT_NEAR((next[i] - previous[i]) / (2 * h), firstDerivative,
+                1e-5);
+            EXPECT_NEAR((next[i] - 2 * value + previous[i]) / (h * h),
+                secondDerivative, 1e-2);
+        }
+    }
+}
+
+TEST_F(BsplineBasisEvaluatorTests, ShouldEvaluateLowerDegreeFromSharedTables)
+{
+    std::vector<double> knots {
+        0.0, 0.1, 0.1, 0.3, 0.45, 0.6, 0.6, 0.85, 0.9, 1.0
+    };
+
+    fw::BsplineBasisEvaluator cubicEvaluator{3, knots};
+    fw::BsplineBasisEvaluator quadraticEvaluator{2, knots};
+    fw::BsplineBasisEvaluator sharedEvaluator{
+        2,
+        cubicEvaluator.getKnotTables()
+    };
+
+    auto copiedEvaluator = cubicEvaluator;
+    EXPECT_EQ(
+        cubicEvaluator.getKnotTables(),
+        copiedEvaluator.getKnotTables()
+    );
+
+    for (auto parameter = 0.0; parameter < 1.0; parameter += 0.05)
+    {
+        EXPECT_EQ(
+            quadraticEvaluator.evaluate(parameter),
+            sharedEvaluator.evaluate(parameter)
+        );
+    }
+}
@@ -0,0 +1,163 @@
+#include "fw/numerical/BsplineKnotInsertion.hpp"
+#include "fw/numerical/BsplineEquidistantKnotGenerator.hpp"
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+class BsplineKnotInsertionTests:
+    public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        std::vector<glm::dvec3> curvePoints{
+            {0.0, 0.0, 0.0}, {1.0, 2.0, 0.0}, {2.0, -1.0, 1.0},
+            {3.0, 0.5, 2.0}, {4.0, 3.0, 1.0}, {5.0, 0.0, 0.0},
+            {6.0, 1.0, -1.0}
+        };
+
+        _curve = std::make_shared<fw::BsplineCurve3d>(
+            3,
+            curvePoints,
+            _knotGenerator.generate(curvePoints.size(), 3)
+        );
+
+        std::vector<glm::dvec3> surfacePoints;
+        for (auto v = 0; v < 5; ++v)
+        {
+            for (auto u = 0; u < 6; ++u)
+            {
+                surfacePoints.push_back({u, v, std::sin(u + 2.0 * v)});
+            }
+        }
+
+        _surface = std::make_shared<fw::BsplineSurface>(
+            3,
+            glm::ivec2{6, 5},
+            surfacePoints,
+            _knotGenerator.generate(6, 3),
+            _knotGenerator.generate(5 + 3, 3),
+            fw::SurfaceFoldingMode::ContinuousV
+        );
+    }
+
+    virtual void TearDown() override
+    {
+    }
+
+protected:
+    glm::dvec2 getDomainMinimum(const fw::BsplineSurface &surface) const
+    {
+        return {
+            surface.getKnotsOnU()[surface.getDegree()],
+            surface.getKnotsOnV()[surface.getDegree()]
+        };
+    }
+
+    glm::dvec2 getDomainMaximum(const fw::BsplineSurface &surface) const
+    {
+        auto grid = surface.getFoldedGridSize();
+        return {surface.getKnotsOnU()[grid.x], surface.getKnotsOnV()[grid.y]};
+    }
+
+    fw::BsplineEquidistantKnotGenerator _knotGenerator;
+    std::shared_ptr<fw::BsplineCurve3d> _curve;
+    std::shared_ptr<fw::BsplineSurface> _surface;
+};
+
+TEST_F(BsplineKnotInsertionTests, ShouldKeepCurveShapeAfterInsertion)
+{
+    auto refined = fw::insertKnot(*_curve, 0.45, 2);
+
+    ASSERT_EQ(_curve->getControlPoints().size() + 2,
+        refined->getControlPoints().size());
+    EXPECT_EQ(2, fw::getKnotMultiplicity(refined->getKnots(), 0.45));
+
+    for (auto t = 0.3; t < 0.7; t += 0.01)
+    {
+        EXPECT_NEAR(0.0,
+            glm::length(_curve->evaluate(t) - refined->evaluate(t)), 1e-12);
+    }
+}
+
+TEST_F(BsplineKnotInsertionTests, ShouldDecomposeCurveIntoBezierSegments)
+{
+    auto segments = fw::decomposeIntoBezierSegments(*_curve);
+    ASSERT_EQ(4, segments.size());
+
+    for (auto i = 0; i < segments.size(); ++i)
+    {
+        ASSERT_EQ(4, segments[i].size());
+
+        // Bezier segments interpolate their end points
+        auto begin = 0.3 + 0.1 * i;
+        EXPECT_NEAR(0.0,
+            glm::length(_curve->evaluate(begin) - segments[i].front()), 1e-12);
+        if (i > 0)
+        {
+            EXPECT_EQ(segments[i - 1].back(), segments[i].front());
+        }
+    }
+}
+
+TEST_F(BsplineKnotInsertionTests, ShouldExtractCurveSegment)
+{
+    auto segment = fw::extractSegment(*_curve, 0.37, 0.61);
+    ASSERT_EQ(3, segment->getDegree());
+    ASSERT_EQ(segment->getControlPoints().size() + 4,
+        segment->getKnots().size());
+
+    for (auto t = 0.37; t < 0.61; t += 0.01)
+    {
+        EXPECT_NEAR(0.0,
+            glm::length(_curve->evaluate(t) - segment->evaluate(t)), 1e-12);
+    }
+}
+
+TEST_F(BsplineKnotInsertionTests, ShouldDecomposeFoldedSurfaceIntoPatches)
+{
+    auto patches = fw::decomposeIntoBezierPatches(*_surface);
+    auto minimum = getDomainMinimum(*_surface);
+    auto maximum = getDomainMaximum(*_surface);
+
+    ASSERT_EQ(3 * 5, patches.size());
+
+    for (const auto &patch: patches)
+    {
+        EXPECT_EQ(16, patch.controlPoints.size());
+        auto center = 0.5 * (patch.minimumParameter + patch.maximumParameter);
+        for (const auto &parameter: {patch.minimumParameter, center})
+        {
+            auto expected = _surface->getPosition(parameter);
+            EXPECT_NEAR(0.0,
+                glm::length(expected - patch.getPosition(parameter)), 1e-12);
+        }
+
+        EXPECT_TRUE(patch.getBounds().contains(_surface->getPosition(center)));
+
+        EXPECT_TRUE(glm::all(glm::lessThanEqual(minimum,
+            patch.minimumParameter)));
+        EXPECT_TRUE(glm::all(glm::lessThanEqual(patch.maximumParameter,
+            maximum)));
+    }
+}
+
+TEST_F(BsplineKnotInsertionTests, ShouldExtractSurfacePatch)
+{
+    auto refined = fw::insertKnot(*_surface, fw::ParametrizationAxis::V, 0.5);
+    glm::dvec2 minimum{0.35, 0.42}, maximum{0.6, 0.71};
+    auto patch = fw::extractPatch(*_surface, minimum, maximum);
+
+    for (auto u = minimum.x; u < maximum.x; u += 0.02)
+    {
+        for (auto v = minimum.y; v < maximum.y; v += 0.02)
+        {
+            auto expected = _surface->getPosition({u, v});
+            EXPECT_NEAR(0.0,
+                glm::length(expected - refined->getPosition({u, v})), 1e-12);
+            EXPECT_NEAR(0.0,
+                glm::length(expected - patch->getPosition({u, v})), 1e-12);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#include "gtest/gtest.h"
+#include "fw/numerical/BsplineSurfacePatchHierarchy.hpp"
+#include "fw/numerical/CommonBsplineSurfaces.hpp"
+
+class BsplineSurfacePatchHierarchyTests:
+    public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        _horizontalPlane = fw::createBsplinePlane(
+            {0.0, 0.0, 0.0},
+            {1.0, 0.0, 0.0},
+            {0.0, 1.0, 0.0},
+            {1.0, 1.0, 0.0}
+        );
+
+        _verticalPlane = fw::createBsplinePlane(
+            {0.55, 0.1, -1.0},
+            {0.55, 0.9, -1.0},
+            {0.55, 0.1, 1.0},
+            {0.55, 0.9, 1.0}
+        );
+
+        _raisedPlane = fw::createBsplinePlane(
+            {0.0, 0.0, 2.0},
+            {1.0, 0.0, 2.0},
+            {0.0, 1.0, 2.0},
+            {1.0, 1.0, 2.0}
+        );
+    }
+
+protected:
+    std::shared_ptr<fw::BsplineSurface> _horizontalPlane;
+    std::shared_ptr<fw::BsplineSurface> _verticalPlane;
+    std::shared_ptr<fw::BsplineSurface> _raisedPlane;
+};
+
+TEST_F(BsplineSurfacePatchHierarchyTests, ShouldCreatePatchPerKnotSpan)
+{
+    fw::BsplineSurfacePatchHierarchy hierarchy{*_horizontalPlane};
+    EXPECT_EQ(13 * 13, hierarchy.getPatches().size());
+    EXPECT_TRUE(hierarchy.getBounds().contains({0.5, 0.5, 0.0}));
+}
+
+TEST_F(BsplineSurfacePatchHierarchyTests, ShouldRejectDisjointSurfaces)
+{
+    fw::BsplineSurfacePatchHierarchy lhs{*_horizontalPlane};
+    fw::BsplineSurfacePatchHierarchy rhs{*_raisedPlane};
+    EXPECT_TRUE(lhs.findOverlappingPatches(rhs).empty());
+    EXPECT_TRUE(lhs.findIntersectionSeedRegions(rhs).empty());
+}
+
+TEST_F(BsplineSurfacePatchHierarchyTests, ShouldFindSamePairsAsBruteForce)
+{
+    fw::BsplineSurfacePatchHierarchy lhs{*_horizontalPlane};
+    fw::BsplineSurfacePatchHierarchy rhs{*_verticalPlane};
+
+    auto expectedPairs = 0;
+    for (const auto &lhsPatch: lhs.getPatches())
+    {
+        for (const auto &rhsPatch: rhs.getPatches())
+        {
+            if (lhsPatch.bounds.intersect(rhsPatch.bounds).isValid())
+            {
+                ++expectedPairs;
+            }
+        }
+    }
+
+    auto pairs = lhs.findOverlappingPatches(rhs);
+    EXPECT_LT(0, expectedPairs);
+    EXPECT_EQ(expectedPairs, pairs.size());
+}
+
+TEST_F(
+    BsplineSurfacePatchHierarchyTests,
+    ShouldMergeOverlapsAlongSingleIntersectionIntoOneRegion
+)
+{
+    fw::BsplineSurfacePatchHierarchy lhs{*_horizontalPlane};
+    fw::BsplineSurfacePatchHierarchy rhs{*_verticalPlane};
+
+    auto regions = lhs.findIntersectionSeedRegions(rhs);
+    ASSERT_EQ(1, regions.size());
+    EXPECT_TRUE(regions[0].contains({0.55, 0.2, 0.0}));
+    EXPECT_TRUE(regions[0].contains({0.55, 0.8, 0.0}));
+}
+
+TEST_F(BsplineSurfacePatchHierarchyTests, ShouldSeedEveryOverlappingPatchPair)
+{
+    fw::BsplineSurfacePatchHierarchy lhs{*_horizontalPlane};
+    fw::BsplineSurfacePatchHierarchy rhs{*_verticalPlane};
+
+    auto seeds = lhs.findIntersectionSeeds(rhs);
+    EXPECT_EQ(lhs.findOverlappingPatches(rhs).size(), seeds.size());
+
+    // spans are 1/13 wide, patch bounds hull control points reaching to
+    // neighbouring spans, so centres stay within two spans of x = 0.55
+    for (const auto &seed: seeds)
+    {
+        EXPECT_EQ(0, seed.region);
+        EXPECT_NEAR(0.55, seed.lhsParameters.x, 2.0 / 13.0);
+        EXPECT_NEAR(0.5, seed.rhsParameters.y, 2.0 / 13.0);
+    }
+}
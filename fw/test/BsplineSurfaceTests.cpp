@@ -1,3 +1,5 @@
+#include "fw/numerical/BsplineBasisEvaluator.hpp"
+#include "fw/numerical/BsplineNonVanishingReparametrization.hpp"
 #include "fw/numerical/BsplineSurface.hpp"
 #include "IBsplineKnotGeneratorMock.hpp"
 
@@ -54,3 +56,303 @@ TEST_F(BsplineSurfaceTests, ShouldReturnLastCornerPositionForMaxParameters)
     EXPECT_DOUBLE_EQ(0.0, point.y);
     EXPECT_DOUBLE_EQ(3.0, point.z);
 }
+
+TEST_F(BsplineSurfaceTests, ShouldEvaluatePositionLikeConstParameterCurves)
+{
+    fw::BsplineSurface foldedSurface{
+        3,
+        glm::ivec2(4, 4),
+        _controlPoints,
+        _knots,
+        { 0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6, 0.7, 0.8, 0.9, 1.0 },
+        fw::SurfaceFoldingMode::ContinuousV
+    };
+
+    for (const fw::BsplineSurface *surface: {_surface.get(), &foldedSurface})
+    {
+        for (auto u = 0.0; u < 1.0; u += 0.05)
+        {
+            for (auto v = 0.0; v < 1.0; v += 0.05)
+            {
+                auto expected = surface->getConstParameterCurve(
+                    fw::ParametrizationAxis::U,
+                    u
+                )->evaluate(v);
+
+                auto point = surface->getPosition({u, v});
+                EXPECT_DOUBLE_EQ(expected.x, point.x);
+                EXPECT_DOUBLE_EQ(expected.y, point.y);
+                EXPECT_DOUBLE_EQ(expected.z, point.z);
+            }
+        }
+    }
+}
+
+TEST_F(BsplineSurfaceTests, ShouldEvaluateDerivativesConsistentWithCurves)
+{
+    for (auto u = 3.0/7 + 0.005; u < 4.0/7; u += 0.01)
+    {
+        for (auto v = 3.0/7 + 0.005; v < 4.0/7; v += 0.01)
+        {
+            auto evaluation = _surface->evaluate({u, v}, 2);
+
+            auto expectedU = _surface->getConstParameterCurve(
+                fw::ParametrizationAxis::V,
+                v
+            )->getDerivativeCurve()->evaluate(u);
+
+            auto expectedVCurve = _surface->getConstParameterCurve(
+                fw::ParametrizationAxis::U,
+                u
+            )->getDerivativeCurve();
+
+            auto expectedV = expectedVCurve->evaluate(v);
+
+            const double h = 1e-5;
+            auto expectedVV = (_surface->getDerivativeV({u, v + h})
+                - _surface->getDerivativeV({u, v - h})) / (2 * h);
+            auto expectedUV = (_surface->getDerivativeU({u, v + h})
+                - _surface->getDerivativeU({u, v - h})) / (2 * h);
+
+            EXPECT_NEAR(0.0, glm::length(expectedU - evaluation.derivativeU),
+                1e-9);
+            EXPECT_NEAR(0.0, glm::length(expectedV - evaluation.derivativeV),
+                1e-9);
+            EXPECT_NEAR(0.0, glm::length(expectedVV - evaluation.derivativeVV),
+                1e-3);
+            EXPECT_NEAR(0.0, glm::length(expectedUV - evaluation.derivativeUV),
+                1e-3);
+        }
+    }
+}
+
+TEST_F(BsplineSurfaceTests, ShouldEvaluateDerivativeNetsLikeBasisDerivatives)
+{
+    const int degree = 3;
+    std::vector<glm::dvec3> controlPoints;
+    for (auto y = 0; y < 6; ++y)
+    {
+        for (auto x = 0; x < 5; ++x)
+        {
+            controlPoints.push_back({
+                x + 0.3 * y,
+                y - 0.2 * x * x,
+                std::sin(1.3 * x) * std::cos(0.9 * y)
+            });
+        }
+    }
+
+    std::vector<double> knotsU{0.0, 0.1, 0.15, 0.3, 0.45, 0.5, 0.7, 0.8, 1.0};
+    std::vector<double> knotsV{
+        0.0, 0.05, 0.2, 0.25, 0.4, 0.5, 0.55, 0.65, 0.7, 0.8, 0.85, 0.95, 1.0
+    };
+
+    fw::BsplineSurface foldedSurface{
+        degree,
+        glm::ivec2(5, 6),
+        controlPoints,
+        knotsU,
+        knotsV,
+        fw::SurfaceFoldingMode::ContinuousV
+    };
+
+    fw::BsplineSurface surface{
+        degree,
+        glm::ivec2(5, 6),
+        controlPoints,
+        knotsU,
+        std::vector<double>(std::begin(knotsV), std::end(knotsV) - 3)
+    };
+
+    for (const fw::BsplineSurface *tested: {&surface, &foldedSurface})
+    {
+        const auto &testedKnotsU = tested->getKnotsOnU();
+        const auto &testedKnotsV = tested->getKnotsOnV();
+        fw::BsplineBasisEvaluator basisU{degree, testedKnotsU};
+        fw::BsplineBasisEvaluator basisV{degree, testedKnotsV};
+        auto grid = tested->getFoldedGridSize();
+        glm::dvec2 minimum{testedKnotsU[degree], testedKnotsV[degree]};
+        glm::dvec2 maximum{testedKnotsU[grid.x], testedKnotsV[grid.y]};
+
+        for (auto i = 1; i < 20; ++i)
+        {
+            for (auto j = 1; j < 20; ++j)
+            {
+                auto parameters = glm::mix(
+                    minimum,
+                    maximum,
+                    glm::dvec2{i / 20.0, j / 20.0}
+                );
+
+                // derivatives straight from basis derivatives and control
+                // points, rows hold derivatives of order 0, 1 and 2
+                double derivativesU[3 * (degree + 1)];
+                double derivativesV[3 * (degree + 1)];
+                auto spanU = basisU.evaluateNonVanishingDerivatives(
+                    parameters.x,
+                    2,
+                    derivativesU
+                );
+                auto spanV = basisV.evaluateNonVanishingDerivatives(
+                    parameters.y,
+                    2,
+                    derivativesV
+                );
+
+                glm::dvec3 expected[3][3];
+                for (auto y = 0; y <= degree; ++y)
+                {
+                    for (auto x = 0; x <= degree; ++x)
+                    {
+                        const auto &point = tested->getFoldedControlPoint(
+                            spanU - degree + x,
+                            spanV - degree + y
+                        );
+
+                        for (auto k = 0; k <= 2; ++k)
+                        {
+                            for (auto l = 0; k + l <= 2; ++l)
+                            {
+                                expected[k][l] += point
+                                    * derivativesU[k * (degree + 1) + x]
+                                    * derivativesV[l * (degree + 1) + y];
+                            }
+                        }
+                    }
+                }
+
+                auto evaluation = tested->evaluate(parameters, 2);
+                const std::pair<glm::dvec3, glm::dvec3> compared[] = {
+                    {expected[0][0], evaluation.position},
+                    {expected[1][0], evaluation.derivativeU},
+                    {expected[0][1], evaluation.derivativeV},
+                    {expected[2][0], evaluation.derivativeUU},
+                    {expected[1][1], evaluation.derivativeUV},
+                    {expected[0][2], evaluation.derivativeVV}
+                };
+
+                for (const auto &pair: compared)
+                {
+                    EXPECT_NEAR(
+                        0.0,
+                        glm::length(pair.first - pair.second),
+                        1e-9 * (1.0 + glm::length(pair.first))
+                    );
+                }
+            }
+        }
+    }
+}
+
+TEST_F(BsplineSurfaceTests, ShouldSampleGridLikeSingleEvaluations)
+{
+    const glm::ivec2 resolution{7, 5};
+    const glm::dvec2 minimumParameter{0.1, 3.0/7};
+    const glm::dvec2 maximumParameter{0.9, 4.0/7};
+
+    std::vector<glm::dvec3> positions, normals;
+    _surface->sampleGrid(
+        minimumParameter,
+        maximumParameter,
+        resolution,
+        positions,
+        &normals
+    );
+
+    ASSERT_EQ(resolution.x * resolution.y, positions.size());
+    ASSERT_EQ(resolution.x * resolution.y, normals.size());
+
+    for (auto y = 0; y < resolution.y; ++y)
+    {
+        for (auto x = 0; x < resolution.x; ++x)
+        {
+            glm::dvec2 parameter = glm::mix(
+                minimumParameter,
+                maximumParameter,
+                glm::dvec2{x / 6.0, y / 4.0}
+            );
+
+            auto evaluation = _surface->evaluate(parameter, 1);
+            auto index = y * resolution.x + x;
+            EXPECT_NEAR(0.0,
+                glm::length(evaluation.position - positions[index]), 1e-12);
+            EXPECT_NEAR(0.0,
+                glm::length(evaluation.getNormal() - normals[index]), 1e-12);
+        }
+    }
+}
+
+TEST_F(BsplineSurfaceTests, ShouldSampleSinglePrecisionGridLikeDoublePrecision)
+{
+    fw::BsplineSurface quadraticSurface{
+        2,
+        glm::ivec2(4, 4),
+        _controlPoints,
+        { 0.0, 0.1, 0.3, 0.5, 0.6, 0.8, 1.0 },
+        { 0.0, 0.2, 0.4, 0.5, 0.7, 0.9, 1.0 }
+    };
+
+    // bicubic surface goes through fixed degree path, quadratic through
+    // runtime degree one
+    const glm::ivec2 resolution{9, 6};
+    const glm::dvec2 minimumParameter{3.0/7, 3.0/7};
+    const glm::dvec2 maximumParameter{4.0/7, 4.0/7};
+
+    for (const fw::BsplineSurface *surface:
+        {_surface.get(), &quadraticSurface})
+    {
+        std::vector<glm::dvec3> positions, normals;
+        surface->sampleGrid(
+            minimumParameter,
+            maximumParameter,
+            resolution,
+            positions,
+            &normals
+        );
+
+        std::vector<glm::vec3> singlePositions(positions.size());
+        std::vector<glm::vec3> singleNormals(normals.size());
+        surface->sampleGridRowsSinglePrecision(
+            minimumParameter,
+            maximumParameter,
+            resolution,
+            0,
+            resolution.y,
+            singlePositions.data(),
+            singleNormals.data()
+        );
+
+        for (auto i = 0; i < positions.size(); ++i)
+        {
+            EXPECT_NEAR(0.0, glm::length(
+                glm::dvec3(singlePositions[i]) - positions[i]), 1e-5);
+            EXPECT_NEAR(0.0, glm::length(
+                glm::dvec3(singleNormals[i]) - normals[i]), 1e-5);
+        }
+    }
+}
+
+TEST_F(BsplineSurfaceTests, ShouldReparametrizeDomainInDoublePrecision)
+{
+    fw::BsplineNonVanishingReparametrization reparametrization{_surface};
+
+    for (auto u = 0.013; u < 1.0; u += 0.1)
+    {
+        for (auto v = 0.027; v < 1.0; v += 0.1)
+        {
+            auto evaluation = reparametrization.evaluate({u, v}, 2);
+            auto expected = _surface->evaluate(
+                {3.0/7 + u/7, 3.0/7 + v/7},
+                2
+            );
+
+            EXPECT_NEAR(0.0, glm::length(
+                expected.position - evaluation.position), 1e-12);
+            EXPECT_NEAR(0.0, glm::length(
+                expected.derivativeU / 7.0 - evaluation.derivativeU), 1e-12);
+            EXPECT_NEAR(0.0, glm::length(
+                expected.derivativeUV / 49.0 - evaluation.derivativeUV),
+                1e-12);
+        }
+    }
+}
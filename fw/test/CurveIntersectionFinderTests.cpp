@@ -0,0 +1,185 @@
+#include "gtest/gtest.h"
+#include "fw/numerical/BsplineKnotInsertion.hpp"
+#include "fw/numerical/CurveIntersectionFinder.hpp"
+#include "TestBsplineSurfaces.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Cubic curve running along x axis and oscillating on given axis.
+fw::BsplineCurve3d createOscillatingCurve(int axis)
+{
+    const int numPoints = 10;
+    const int degree = 3;
+
+    std::vector<glm::dvec3> controlPoints;
+    for (auto i = 0; i < numPoints; ++i)
+    {
+        glm::dvec3 point{1.5 + 0.5 * i, 3.3, 0.0};
+        point[axis] = i % 2 == 0 ? 0.8 : -0.7;
+        controlPoints.push_back(point);
+    }
+
+    std::vector<double> knots;
+    for (auto i = 0; i < numPoints + degree + 1; ++i)
+    {
+        knots.push_back(i);
+    }
+
+    return {degree, controlPoints, knots};
+}
+
+// Counts sign changes of coordinate of the curve over its domain.
+int countCrossings(const fw::BsplineCurve3d &curve, int axis)
+{
+    const int numSamples = 10000;
+    const auto &knots = curve.getKnots();
+    auto begin = knots[curve.getDegree()];
+    auto end = knots[curve.getControlPoints().size()];
+
+    auto crossings = 0;
+    auto previous = curve.evaluate(begin)[axis];
+    for (auto i = 1; i <= numSamples; ++i)
+    {
+        auto value = curve.evaluate(begin + (end - begin) * i / numSamples);
+        if ((previous < 0.0) != (value[axis] < 0.0))
+        {
+            ++crossings;
+        }
+
+        previous = value[axis];
+    }
+
+    return crossings;
+}
+
+}
+
+TEST(CurveIntersectionFinderTests, ShouldFindAllCurveSurfaceIntersections)
+{
+    auto surface = createWavyBsplineSurface(8, 0.0, 0.0);
+    auto curve = createOscillatingCurve(2);
+
+    fw::CurveIntersectionFinder finder;
+    auto intersections = finder.intersect(
+        fw::decomposeIntoBezierCurveSegments(curve),
+        *surface
+    );
+
+    ASSERT_EQ(countCrossings(curve, 2), intersections.size());
+    for (auto i = 0; i < intersections.size(); ++i)
+    {
+        const auto &intersection = intersections[i];
+        EXPECT_NEAR(0.0, intersection.scenePosition.z, 1e-7);
+        EXPECT_NEAR(
+            0.0,
+            glm::length(
+                curve.evaluate(intersection.curveParameter)
+                - intersection.scenePosition
+            ),
+            1e-9
+        );
+
+        if (i > 0)
+        {
+            EXPECT_LT(
+                intersections[i - 1].curveParameter,
+                intersection.curveParameter
+            );
+        }
+    }
+
+    // every root is seeded only by few neighbouring leaf pairs
+    EXPECT_LE(finder.getNewtonSolvesCount(), 4 * intersections.size());
+}
+
+TEST(CurveIntersectionFinderTests, ShouldIntersectPolylineWithCurvedSurface)
+{
+    auto surface = createWavyBsplineSurface(8, 0.0, 1.0);
+    glm::dvec2 point{3.4, 4.1};
+
+    fw::CurveIntersectionFinder finder;
+    auto intersections = finder.intersect(
+        fw::createPolylineSegments({
+            {point.x, point.y, -3.0},
+            {point.x, point.y, 0.0},
+            {point.x, point.y, 3.0}
+        }),
+        *surface
+    );
+
+    ASSERT_EQ(1, intersections.size());
+
+    const auto &intersection = intersections.front();
+    auto surfacePosition = surface->getPosition(intersection.surfaceParameters);
+    EXPECT_NEAR(point.x, intersection.scenePosition.x, 1e-9);
+    EXPECT_NEAR(point.y, intersection.scenePosition.y, 1e-9);
+    EXPECT_NEAR(
+        0.0,
+        glm::length(surfacePosition - intersection.scenePosition),
+        1e-7
+    );
+}
+
+TEST(CurveIntersectionFinderTests, ShouldFindAllCurveCurveIntersections)
+{
+    auto curve = createOscillatingCurve(1);
+    auto line = fw::createPolylineSegments({
+        {0.0, 0.0, 0.0},
+        {2.5, 0.0, 0.0},
+        {7.0, 0.0, 0.0}
+    });
+
+    fw::CurveIntersectionFinder finder;
+    auto intersections = finder.intersect(
+        fw::decomposeIntoBezierCurveSegments(curve),
+        line
+    );
+
+    ASSERT_EQ(countCrossings(curve, 1), intersections.size());
+    for (const auto &intersection: intersections)
+    {
+        EXPECT_NEAR(0.0, intersection.scenePosition.y, 1e-7);
+        EXPECT_NEAR(0.0, intersection.scenePosition.z, 1e-7);
+
+        auto linePosition = intersection.rhsParameter < 1.0
+            ? line[0].getPosition(intersection.rhsParameter)
+            : line[1].getPosition(intersection.rhsParameter);
+        EXPECT_NEAR(
+            0.0,
+            glm::length(linePosition - intersection.scenePosition),
+            1e-7
+        );
+    }
+}
+
+TEST(CurveIntersectionFinderTests, ShouldSeparateRootsCloserThanSeedSize)
+{
+    // quadratic dips 1e-6 below the line, roots are 0.002 apart
+    const double dip = 1e-6;
+    fw::BezierCurveSegment curve;
+    curve.degree = 2;
+    curve.minimumParameter = 0.0;
+    curve.maximumParameter = 1.0;
+    curve.controlPoints = {
+        {-1.0, 1.0, 0.0},
+        {0.0, -1.0 - 2.0 * dip, 0.0},
+        {1.0, 1.0, 0.0}
+    };
+
+    auto line = fw::createPolylineSegments({
+        {-2.0, 0.0, 0.0},
+        {2.0, 0.0, 0.0}
+    });
+
+    fw::CurveIntersectionFinder finder;
+    auto intersections = finder.intersect({curve}, line);
+
+    ASSERT_EQ(2, intersections.size());
+    auto root = std::sqrt(dip / (1.0 + dip));
+    EXPECT_NEAR(-root, intersections[0].scenePosition.x, 1e-6);
+    EXPECT_NEAR(root, intersections[1].scenePosition.x, 1e-6);
+}
@@ -0,0 +1,103 @@
+#include "fw/CurveSimplifier.hpp"
+#include "gtest/gtest.h"
+#include "glm/glm.hpp"
+
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Noisy spiral, dense enough to be simplified substantially.
+std::vector<glm::dvec2> createNoisySpiral(int numPoints)
+{
+    std::mt19937 generator{11};
+    std::uniform_real_distribution<double> noise{-1e-4, 1e-4};
+
+    std::vector<glm::dvec2> points;
+    for (auto i = 0; i < numPoints; ++i)
+    {
+        auto angle = 40.0 * i / numPoints;
+        auto radius = 1.0 + 0.1 * angle;
+        points.push_back({
+            radius * std::cos(angle) + noise(generator),
+            radius * std::sin(angle) + noise(generator)
+        });
+    }
+
+    return points;
+}
+
+// Largest distance of input point from the simplified polyline. Kept
+// points are a subsequence of input, so every point is measured against
+// the segment spanning it.
+double getMaximumDeviation(
+    const std::vector<glm::dvec2> &curve,
+    const std::vector<glm::dvec2> &simplified
+)
+{
+    auto maximum = 0.0;
+    auto segment = 0;
+    for (const auto &point: curve)
+    {
+        if (segment + 2 < simplified.size()
+            && point == simplified[segment + 1])
+        {
+            ++segment;
+        }
+
+        auto start = simplified[segment];
+        auto direction = simplified[segment + 1] - start;
+        auto t = glm::clamp(
+            glm::dot(point - start, direction) / glm::dot(direction, direction),
+            0.0,
+            1.0
+        );
+        maximum = std::max(maximum, glm::length(point - start - t * direction));
+    }
+
+    return maximum;
+}
+
+}
+
+TEST(CurveSimplifierTests, ShouldKeepEveryPointWithinMaximumDeviation)
+{
+    auto curve = createNoisySpiral(20000);
+
+    fw::CurveSimplifier<glm::dvec2, double> simplifier;
+    simplifier.setMaximumDeviation(1e-3);
+    auto simplified = simplifier.simplifyWithinDeviation(curve);
+
+    ASSERT_LE(2, simplified.size());
+    EXPECT_GT(curve.size() / 10, simplified.size());
+    EXPECT_EQ(curve.front(), simplified.front());
+    EXPECT_EQ(curve.back(), simplified.back());
+    EXPECT_GE(1e-3, getMaximumDeviation(curve, simplified));
+}
+
+TEST(CurveSimplifierTests, ShouldStitchChunksSimplifiedInParallel)
+{
+    auto curve = createNoisySpiral(100000);
+
+    fw::CurveSimplifier<glm::dvec2, double> simplifier;
+    simplifier.setMaximumDeviation(1e-3);
+    auto serial = simplifier.simplifyWithinDeviation(curve);
+
+    simplifier.setThreadPool(std::make_shared<fw::ThreadPool>(4));
+    simplifier.setParallelChunkSize(4096);
+    auto parallel = simplifier.simplifyWithinDeviation(curve);
+
+    EXPECT_GE(1e-3, getMaximumDeviation(curve, parallel));
+    EXPECT_LE(parallel.size(), serial.size() + serial.size() / 10);
+
+    std::vector<glm::dvec2> line;
+    for (auto i = 0; i < 100000; ++i)
+    {
+        line.push_back({1e-3 * i, 2e-3 * i});
+    }
+
+    EXPECT_EQ(2, simplifier.simplifyWithinDeviation(line).size());
+}
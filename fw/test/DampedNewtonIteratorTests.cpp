@@ -0,0 +1,128 @@
+#include "gtest/gtest.h"
+#include "fw/numerical/DampedNewtonIterator.hpp"
+#include <cmath>
+
+namespace
+{
+
+// F(x, y) = (atan(x), y - 1), full Newton steps on x overshoot further
+// with every iteration when started far enough from the root.
+class ArcTangentIterable:
+    public fw::INewtonIterable<glm::dvec2, glm::dvec2, glm::dmat2>
+{
+public:
+    virtual void setInitialParameters(const glm::dvec2&) override
+    {
+    }
+
+    virtual void setCurrentParameters(const glm::dvec2& parameters) override
+    {
+        _parameters = parameters;
+    }
+
+    virtual bool hasParameterConverged(
+        const glm::dvec2& newParameters
+    ) const override
+    {
+        return glm::length(newParameters - _parameters) < 1e-10;
+    }
+
+    virtual bool areParametersValid(
+        const glm::dvec2& parameters
+    ) const override
+    {
+        return std::abs(parameters.x) < 1e6 && !std::isnan(parameters.x);
+    }
+
+    virtual glm::dvec2 evaluateFunction() const override
+    {
+        return {std::atan(_parameters.x), _parameters.y - 1.0};
+    }
+
+    virtual glm::dmat2 getJacobian() const override
+    {
+        return glm::dmat2{
+            {1.0 / (1.0 + _parameters.x * _parameters.x), 0.0},
+            {0.0, 1.0}
+        };
+    }
+
+    virtual glm::dmat2 getJacobianInverse() const override
+    {
+        return glm::inverse(getJacobian());
+    }
+
+    virtual glm::dvec2 correctParametrisation(
+        const glm::dvec2& parameters
+    ) const override
+    {
+        return parameters;
+    }
+
+private:
+    glm::dvec2 _parameters;
+};
+
+}
+
+TEST(DampedNewtonIteratorTests, ShouldSolveLinearSystemLikeInverse)
+{
+    glm::dmat4 matrix{
+        {0.0, 2.0, 1.0, -1.0},
+        {3.0, 0.5, 0.0, 2.0},
+        {1.0, -1.0, 4.0, 0.0},
+        {2.0, 1.0, 1.0, 0.3}
+    };
+    glm::dvec4 rhs{1.0, -2.0, 0.5, 3.0};
+
+    glm::dvec4 solution;
+    ASSERT_TRUE(fw::solveLinearSystem(matrix, rhs, solution));
+
+    auto expected = glm::inverse(matrix) * rhs;
+    for (auto i = 0; i < 4; ++i)
+    {
+        EXPECT_NEAR(expected[i], solution[i], 1e-12);
+    }
+
+    glm::dmat4 singular{
+        {1.0, 2.0, 3.0, 4.0},
+        {2.0, 4.0, 6.0, 8.0},
+        {0.0, 1.0, 0.0, 1.0},
+        {1.0, 0.0, 1.0, 0.0}
+    };
+
+    EXPECT_FALSE(fw::solveLinearSystem(singular, rhs, solution));
+}
+
+TEST(DampedNewtonIteratorTests, ShouldConvergeWhereFullStepsDiverge)
+{
+    ArcTangentIterable iterable;
+    glm::dvec2 start{2.0, 1.0};
+
+    fw::NewtonIterator<glm::dvec2, glm::dvec2, glm::dmat2> fullStepIterator;
+    auto fullStepResult = fullStepIterator.iterate(iterable, start);
+    EXPECT_NE(
+        fw::NewtonIterationExitStatus::Success,
+        fullStepResult.exitStatus
+    );
+
+    fw::DampedNewtonIterator<glm::dvec2, glm::dvec2, glm::dmat2> iterator;
+    iterator.setRecordingHistory(true);
+    auto result = iterator.iterate(iterable, start);
+
+    ASSERT_EQ(fw::NewtonIterationExitStatus::Success, result.exitStatus);
+    EXPECT_NEAR(0.0, result.parameters.x, 1e-9);
+    EXPECT_NEAR(1.0, result.parameters.y, 1e-9);
+    EXPECT_LT(result.iterations, 20);
+    EXPECT_LT(result.residualNorm, 1e-9);
+
+    ASSERT_EQ(result.iterations, result.history.size());
+    EXPECT_LT(result.history.front().stepScale, 1.0);
+    for (auto i = 1; i < result.history.size(); ++i)
+    {
+        EXPECT_LT(
+            result.history[i].residualNorm,
+            result.history[i - 1].residualNorm
+        );
+    }
+}
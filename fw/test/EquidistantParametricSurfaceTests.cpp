@@ -0,0 +1,150 @@
+#include "gtest/gtest.h"
+#include "fw/numerical/BsplineSurface.hpp"
+#include "fw/numerical/EquidistantParametricSurface.hpp"
+#include "TestBsplineSurfaces.hpp"
+#include <memory>
+
+namespace
+{
+
+// Offset of wavy surface, scale shrinks both the surface and distance.
+std::shared_ptr<fw::EquidistantParametricSurface> createOffsetSurface(
+    double distance,
+    double scale = 1.0
+)
+{
+    auto wavySurface = createWavyBsplineSurface(7, 0.0, 1.0);
+
+    std::vector<glm::dvec3> controlPoints;
+    for (const auto &point: wavySurface->getControlPoints())
+    {
+        controlPoints.push_back(scale * point);
+    }
+
+    return std::make_shared<fw::EquidistantParametricSurface>(
+        std::make_shared<fw::BsplineSurface>(
+            wavySurface->getDegree(),
+            glm::ivec2{7, 7},
+            controlPoints,
+            wavySurface->getKnotsOnU(),
+            wavySurface->getKnotsOnV()
+        ),
+        scale * distance
+    );
+}
+
+void expectSameDerivativesAnalyticallyAndNumerically(
+    const fw::EquidistantParametricSurface &surface,
+    double tolerance
+)
+{
+    const double step = 1e-6;
+    for (auto parameters: {
+        glm::dvec2{0.3, 0.6},
+        glm::dvec2{0.55, 0.2},
+        glm::dvec2{0.8, 0.75}
+    })
+    {
+        auto evaluation = surface.evaluate(parameters, 1);
+        auto numericU = (
+            surface.getPosition(parameters + glm::dvec2{step, 0.0})
+            - surface.getPosition(parameters - glm::dvec2{step, 0.0})
+        ) / (2.0 * step);
+        auto numericV = (
+            surface.getPosition(parameters + glm::dvec2{0.0, step})
+            - surface.getPosition(parameters - glm::dvec2{0.0, step})
+        ) / (2.0 * step);
+
+        for (auto i = 0; i < 3; ++i)
+        {
+            EXPECT_NEAR(numericU[i], evaluation.derivativeU[i], tolerance);
+            EXPECT_NEAR(numericV[i], evaluation.derivativeV[i], tolerance);
+        }
+    }
+}
+
+}
+
+TEST(
+    EquidistantParametricSurfaceTests,
+    ShouldComputeSameDerivativesAnalyticallyAndNumerically
+)
+{
+    expectSameDerivativesAnalyticallyAndNumerically(
+        *createOffsetSurface(0.4),
+        1e-4
+    );
+}
+
+TEST(
+    EquidistantParametricSurfaceTests,
+    ShouldComputeDerivativesOfMicroscopicSurface
+)
+{
+    // fundamental form determinant is far below machine epsilon here
+    expectSameDerivativesAnalyticallyAndNumerically(
+        *createOffsetSurface(0.4, 1e-6),
+        1e-10
+    );
+}
+
+TEST(
+    EquidistantParametricSurfaceTests,
+    ShouldDifferentiateConstParameterCurvesOfOffset
+)
+{
+    const double step = 1e-6;
+    auto surface = createOffsetSurface(0.4);
+
+    for (auto axis: {fw::ParametrizationAxis::U, fw::ParametrizationAxis::V})
+    {
+        auto curve = surface->getConstParameterCurve(axis, 0.45);
+        auto derivative = curve->getDerivativeCurve();
+        auto secondDerivative = derivative->getDerivativeCurve();
+
+        // second derivative of offset jumps at knots, samples avoid them
+        for (auto t: {0.33, 0.55, 0.67})
+        {
+            auto numeric = (curve->evaluate(t + step)
+                - curve->evaluate(t - step)) / (2.0 * step);
+            auto numericSecond = (derivative->evaluate(t + step)
+                - derivative->evaluate(t - step)) / (2.0 * step);
+
+            auto analytic = derivative->evaluate(t);
+            auto second = secondDerivative->evaluate(t);
+            for (auto i = 0; i < 3; ++i)
+            {
+                EXPECT_NEAR(numeric[i], analytic[i], 1e-4);
+                EXPECT_NEAR(numericSecond[i], second[i], 1e-3);
+            }
+        }
+    }
+}
+
+TEST(
+    EquidistantParametricSurfaceTests,
+    ShouldKeepNormalOfReferenceSurface
+)
+{
+    auto surface = createOffsetSurface(-0.25);
+    glm::dvec2 parameters{0.42, 0.37};
+
+    auto evaluation = surface->evaluate(parameters, 2);
+    auto referenceNormal = surface->getReferenceSurface()->getNormal(
+        parameters
+    );
+
+    EXPECT_EQ(fw::EquidistantParametricSurface::MaxDerivativeOrder,
+        evaluation.order);
+
+    // derivatives of offset are tangent to it as well
+    EXPECT_NEAR(0.0, glm::dot(evaluation.derivativeU, referenceNormal), 1e-9);
+    EXPECT_NEAR(0.0, glm::dot(evaluation.derivativeV, referenceNormal), 1e-9);
+
+    auto normal = surface->getNormal(parameters);
+    for (auto i = 0; i < 3; ++i)
+    {
+        EXPECT_NEAR(referenceNormal[i], normal[i], 1e-9);
+        EXPECT_NEAR(referenceNormal[i], evaluation.getNormal()[i], 1e-9);
+    }
+}
@@ -2,6 +2,36 @@
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "glm/glm.hpp"
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+// Random polyline in unit square, every fifth segment lies on the same
+// line as its predecessor to exercise parallel cases.
+std::vector<glm::dvec2> createRandomPolyline(int numPoints, unsigned seed)
+{
+    std::mt19937 generator{seed};
+    std::uniform_real_distribution<double> distribution{0.0, 1.0};
+
+    std::vector<glm::dvec2> points;
+    for (auto i = 0; i < numPoints; ++i)
+    {
+        if (i >= 2 && i % 5 == 0)
+        {
+            points.push_back(2.0 * points[i - 1] - points[i - 2]);
+            continue;
+        }
+
+        points.push_back({distribution(generator), distribution(generator)});
+    }
+
+    return points;
+}
+
+}
 
 TEST(intersectSegments, ShouldHandleCollinearCaseSameDirection)
 {
@@ -159,3 +189,293 @@ TEST(
 
     EXPECT_EQ(0, result.size());
 }
+
+TEST(intersectSegmentBatch, ShouldReportSameIntersectionsAsPairwiseTests)
+{
+    auto lhs = createRandomPolyline(8, 1);
+    auto rhs = createRandomPolyline(300, 2);
+
+    fw::SegmentBatch<double> batch;
+    for (auto i = 0; i + 1 < rhs.size(); ++i)
+    {
+        batch.add(rhs[i], rhs[i + 1]);
+    }
+
+    for (auto i = 0; i + 1 < lhs.size(); ++i)
+    {
+        std::vector<fw::SegmentIntersectionHit<double>> hits;
+        fw::intersectSegmentBatch(lhs[i], lhs[i + 1], batch, hits, i);
+
+        auto hit = std::begin(hits);
+        for (auto j = 0; j + 1 < rhs.size(); ++j)
+        {
+            auto expected = fw::intersectSegments<glm::dvec2, double>(
+                lhs[i],
+                lhs[i + 1],
+                rhs[j],
+                rhs[j + 1]
+            );
+
+            if (expected.kind == fw::GeometricIntersectionKind::None)
+            {
+                continue;
+            }
+
+            ASSERT_NE(std::end(hits), hit);
+            EXPECT_EQ(i, hit->lhsIndex);
+            EXPECT_EQ(j, hit->rhsIndex);
+            EXPECT_EQ(expected.kind, hit->result.kind);
+            EXPECT_NEAR(expected.t0, hit->result.t0, 1e-12);
+            EXPECT_NEAR(expected.t1, hit->result.t1, 1e-12);
+            ++hit;
+        }
+
+        EXPECT_EQ(std::end(hits), hit);
+    }
+}
+
+TEST(intersectSegmentBatches, ShouldReportSameIntersectionsAsPairwiseTests)
+{
+    auto lhs = createRandomPolyline(150, 3);
+    auto rhs = createRandomPolyline(200, 4);
+
+    fw::SegmentBatch<double> lhsBatch, rhsBatch;
+    for (auto i = 0; i + 1 < lhs.size(); ++i)
+    {
+        lhsBatch.add(lhs[i], lhs[i + 1]);
+    }
+
+    for (auto i = 0; i + 1 < rhs.size(); ++i)
+    {
+        rhsBatch.add(rhs[i], rhs[i + 1]);
+    }
+
+    std::vector<fw::SegmentIntersectionHit<double>> hits;
+    fw::intersectSegmentBatches<glm::dvec2>(lhsBatch, rhsBatch, hits);
+    EXPECT_FALSE(hits.empty());
+
+    auto hit = std::begin(hits);
+    for (auto i = 0; i + 1 < lhs.size(); ++i)
+    {
+        for (auto j = 0; j + 1 < rhs.size(); ++j)
+        {
+            auto expected = fw::intersectSegments<glm::dvec2, double>(
+                lhs[i],
+                lhs[i + 1],
+                rhs[j],
+                rhs[j + 1]
+            );
+
+            if (expected.kind == fw::GeometricIntersectionKind::None)
+            {
+                continue;
+            }
+
+            ASSERT_NE(std::end(hits), hit);
+            EXPECT_EQ(i, hit->lhsIndex);
+            EXPECT_EQ(j, hit->rhsIndex);
+            EXPECT_EQ(expected.kind, hit->result.kind);
+            EXPECT_NEAR(expected.t0, hit->result.t0, 1e-12);
+            ++hit;
+        }
+    }
+
+    EXPECT_EQ(std::end(hits), hit);
+}
+
+TEST(intersectPolylines, ShouldReportSameIntersectionsAsPairwiseTests)
+{
+    auto lhs = createRandomPolyline(300, 6);
+    auto rhs = createRandomPolyline(250, 7);
+
+    auto hits = fw::intersectPolylines<glm::dvec2, double>(lhs, rhs);
+    EXPECT_FALSE(hits.empty());
+
+    auto hit = std::begin(hits);
+    for (auto i = 0; i + 1 < lhs.size(); ++i)
+    {
+        for (auto j = 0; j + 1 < rhs.size(); ++j)
+        {
+            auto expected = fw::intersectSegments<glm::dvec2, double>(
+                lhs[i],
+                lhs[i + 1],
+                rhs[j],
+                rhs[j + 1]
+            );
+
+            if (expected.kind == fw::GeometricIntersectionKind::None)
+            {
+                continue;
+            }
+
+            ASSERT_NE(std::end(hits), hit);
+            EXPECT_EQ(i, hit->lhsIndex);
+            EXPECT_EQ(j, hit->rhsIndex);
+            EXPECT_EQ(expected.kind, hit->result.kind);
+
+            auto lhsPosition = glm::mix(lhs[i], lhs[i + 1], hit->result.t0);
+            auto rhsPosition = glm::mix(rhs[j], rhs[j + 1], hit->rhsResult.t0);
+            EXPECT_NEAR(0.0, glm::length(lhsPosition - rhsPosition), 1e-9);
+            ++hit;
+        }
+    }
+
+    EXPECT_EQ(std::end(hits), hit);
+}
+
+TEST(intersectPolylines, ShouldReportCrossingsOfPolylinesRunningAlongY)
+{
+    // both polylines wind around x = 0 and cross each other many times,
+    // x sweep would keep all their segments active
+    std::vector<glm::dvec2> lhs;
+    std::vector<glm::dvec2> rhs;
+    for (auto i = 0; i < 2000; ++i)
+    {
+        auto y = 0.5 * i;
+        lhs.push_back({std::sin(0.3 * i), y});
+        rhs.push_back({std::cos(0.37 * i), y});
+    }
+
+    auto hits = fw::intersectPolylines<glm::dvec2, double>(lhs, rhs);
+    EXPECT_LT(100, hits.size());
+
+    auto hit = std::begin(hits);
+    for (auto i = 0; i + 1 < lhs.size(); ++i)
+    {
+        // segments further apart do not share y range
+        for (auto j = std::max(0, i - 1); j <= i + 1 && j + 1 < rhs.size();
+            ++j)
+        {
+            auto expected = fw::intersectSegments<glm::dvec2, double>(
+                lhs[i],
+                lhs[i + 1],
+                rhs[j],
+                rhs[j + 1]
+            );
+
+            if (expected.kind == fw::GeometricIntersectionKind::None)
+            {
+                continue;
+            }
+
+            ASSERT_NE(std::end(hits), hit);
+            EXPECT_EQ(i, hit->lhsIndex);
+            EXPECT_EQ(j, hit->rhsIndex);
+            EXPECT_EQ(expected.kind, hit->result.kind);
+            ++hit;
+        }
+    }
+
+    EXPECT_EQ(std::end(hits), hit);
+}
+
+TEST(findSelfIntersections, ShouldReportSameIntersectionsAsPairwiseTests)
+{
+    auto points = createRandomPolyline(400, 8);
+
+    auto hits = fw::findSelfIntersections<glm::dvec2, double>(points);
+    EXPECT_FALSE(hits.empty());
+
+    auto hit = std::begin(hits);
+    for (auto i = 0; i + 1 < points.size(); ++i)
+    {
+        for (auto j = i + 1; j + 1 < points.size(); ++j)
+        {
+            auto expected = fw::intersectSegments<glm::dvec2, double>(
+                points[i],
+                points[i + 1],
+                points[j],
+                points[j + 1]
+            );
+
+            auto isVertexContact = j == i + 1
+                && expected.t1 - expected.t0 <= 10e-6;
+            if (expected.kind == fw::GeometricIntersectionKind::None
+                || isVertexContact)
+            {
+                continue;
+            }
+
+            ASSERT_NE(std::end(hits), hit);
+            EXPECT_EQ(i, hit->lhsIndex);
+            EXPECT_EQ(j, hit->rhsIndex);
+            EXPECT_EQ(expected.kind, hit->result.kind);
+            EXPECT_NEAR(expected.t0, hit->result.t0, 1e-12);
+            ++hit;
+        }
+    }
+
+    EXPECT_EQ(std::end(hits), hit);
+}
+
+TEST(findSelfIntersections, ShouldIgnoreClosingVertexOfClosedPolyline)
+{
+    auto hits = fw::findSelfIntersections<glm::dvec2, double>({
+        {0.0, 0.0},
+        {1.0, 1.0},
+        {1.0, 0.0},
+        {0.0, 1.0},
+        {0.0, 0.0}
+    });
+
+    ASSERT_EQ(1, hits.size());
+    EXPECT_EQ(0, hits[0].lhsIndex);
+    EXPECT_EQ(2, hits[0].rhsIndex);
+    EXPECT_EQ(fw::GeometricIntersectionKind::Single, hits[0].result.kind);
+    EXPECT_NEAR(0.5, hits[0].result.t0, 1e-12);
+    EXPECT_NEAR(0.5, hits[0].rhsResult.t0, 1e-12);
+}
+
+TEST(intersectCircleBatch, ShouldReportSameIntersectionsAsPairwiseTests)
+{
+    std::mt19937 generator{5};
+    std::uniform_real_distribution<double> distribution{0.0, 1.0};
+
+    fw::CircleBatch<double> batch;
+    std::vector<glm::dvec2> origins;
+    std::vector<double> radii;
+    for (auto i = 0; i < 200; ++i)
+    {
+        origins.push_back({distribution(generator), distribution(generator)});
+        radii.push_back(0.3 * distribution(generator));
+        batch.add(origins.back(), radii.back());
+    }
+
+    // tangent circle has single intersection
+    origins.push_back({0.5 + 0.2 + radii.front(), 0.5});
+    radii.push_back(radii.front());
+    batch.add(origins.back(), radii.back());
+
+    glm::dvec2 origin{0.5, 0.5};
+    std::vector<fw::CircleIntersectionHit<glm::dvec2>> hits;
+    fw::intersectCircleBatch(origin, 0.2, batch, hits);
+
+    auto hit = std::begin(hits);
+    for (auto i = 0; i < origins.size(); ++i)
+    {
+        auto expected = fw::intersectCircles<glm::dvec2, double>(
+            origin,
+            0.2,
+            origins[i],
+            radii[i]
+        );
+
+        if (expected.empty())
+        {
+            continue;
+        }
+
+        ASSERT_NE(std::end(hits), hit);
+        EXPECT_EQ(i, hit->rhsIndex);
+        ASSERT_EQ(expected.size(), hit->numPoints);
+        for (auto p = 0; p < expected.size(); ++p)
+        {
+            EXPECT_DOUBLE_EQ(expected[p].x, hit->points[p].x);
+            EXPECT_DOUBLE_EQ(expected[p].y, hit->points[p].y);
+        }
+
+        ++hit;
+    }
+
+    EXPECT_EQ(std::end(hits), hit);
+}
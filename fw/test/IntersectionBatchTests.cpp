@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+#include "fw/numerical/BsplineNonVanishingReparametrization.hpp"
+#include "fw/numerical/CommonBsplineSurfaces.hpp"
+#include "fw/numerical/IntersectionBatch.hpp"
+
+namespace
+{
+
+std::shared_ptr<fw::IParametricSurfaceUV> createPlane(
+    glm::dvec3 uv0,
+    glm::dvec3 u1,
+    glm::dvec3 v1,
+    glm::dvec3 uv1
+)
+{
+    return std::make_shared<fw::BsplineNonVanishingReparametrization>(
+        fw::createBsplinePlane(uv0, u1, v1, uv1)
+    );
+}
+
+}
+
+TEST(IntersectionBatchTests, ShouldReturnSameCurvesInOrderAsSerialFinder)
+{
+    auto horizontalPlane = createPlane(
+        {0.0, 0.0, 0.0},
+        {4.0, 0.0, 0.0},
+        {0.0, 4.0, 0.0},
+        {4.0, 4.0, 0.0}
+    );
+
+    fw::IntersectionBatch batch;
+    batch.setThreadPool(std::make_shared<fw::ThreadPool>(4));
+
+    std::vector<std::shared_ptr<fw::IParametricSurfaceUV>> verticalPlanes;
+    for (auto i = 0; i < 6; ++i)
+    {
+        auto y = 0.5 + 0.5 * i;
+        verticalPlanes.push_back(createPlane(
+            {-1.0, y, -1.0},
+            {5.0, y, -1.0},
+            {-1.0, y, 1.0},
+            {5.0, y, 1.0}
+        ));
+
+        EXPECT_EQ(i, batch.addPair(
+            horizontalPlane,
+            verticalPlanes.back(),
+            glm::dvec3{2.0, y, 0.0}
+        ));
+    }
+
+    auto results = batch.run();
+    ASSERT_EQ(verticalPlanes.size(), results.size());
+
+    for (auto i = 0; i < verticalPlanes.size(); ++i)
+    {
+        fw::ParametricSurfaceIntersectionFinder finder;
+        auto expectedCurve = finder.intersect(
+            horizontalPlane,
+            verticalPlanes[i],
+            glm::vec3{2.0f, 0.5f + 0.5f * i, 0.0f}
+        );
+
+        const auto &curves = results[i].curves;
+        ASSERT_EQ(1, curves.size());
+        ASSERT_EQ(expectedCurve.size(), curves[0].size());
+        for (auto j = 0; j < expectedCurve.size(); ++j)
+        {
+            EXPECT_EQ(
+                expectedCurve[j].scenePosition,
+                curves[0][j].scenePosition
+            );
+        }
+
+        // open curve ends on both sides of the domain
+        const auto &expectedStop = finder.getTracingStops().front();
+        ASSERT_EQ(1, results[i].tracingStops.size());
+        EXPECT_EQ(expectedStop.forward, results[i].tracingStops[0].forward);
+        EXPECT_EQ(expectedStop.backward, results[i].tracingStops[0].backward);
+        EXPECT_NE(
+            fw::IntersectionTracingStopReason::LoopClosed,
+            results[i].tracingStops[0].forward
+        );
+    }
+}
@@ -0,0 +1,88 @@
+#include "gtest/gtest.h"
+#include "fw/numerical/IntersectionCurve.hpp"
+#include <cmath>
+
+namespace
+{
+
+fw::ParametricSurfaceIntersection createHelixPoint(int index)
+{
+    auto angle = 0.01 * index;
+    return {
+        {},
+        {},
+        {std::cos(angle), std::sin(angle), 0.00001 * index}
+    };
+}
+
+}
+
+TEST(IntersectionCurveTests, ShouldLoopBackToEarliestPointInRange)
+{
+    fw::IntersectionCurve curve;
+    curve.setLooping(true);
+    curve.setLoopbackMinimumIndexDifference(20);
+    curve.setLoopBackDistance(0.05);
+
+    // single turn of helix takes ~628 points
+    auto loopedBackIndex = -1;
+    for (auto i = 0; i < 10000; ++i)
+    {
+        auto result = curve.addCurvePoint(createHelixPoint(i));
+        if (result == fw::IntersectionCurveAddingResult::LoopedBack)
+        {
+            loopedBackIndex = i;
+            break;
+        }
+    }
+
+    ASSERT_LT(600, loopedBackIndex);
+    ASSERT_GT(640, loopedBackIndex);
+
+    const auto &points = curve.getCurvePoints();
+    ASSERT_EQ(loopedBackIndex + 1, points.size());
+    EXPECT_EQ(points.front().scenePosition, points.back().scenePosition);
+}
+
+TEST(IntersectionCurveTests, ShouldNotLoopBackOnLongOpenCurve)
+{
+    fw::IntersectionCurve curve;
+    curve.setLooping(true);
+    curve.setLoopbackMinimumIndexDifference(20);
+    curve.setLoopBackDistance(0.005);
+
+    // turns are 0.0628 apart on z, far above loop back distance
+    auto lastPoint = createHelixPoint(0);
+    for (auto i = 0; i < 20000; ++i)
+    {
+        lastPoint = createHelixPoint(i);
+        lastPoint.scenePosition.z *= 1000.0;
+        ASSERT_EQ(
+            fw::IntersectionCurveAddingResult::Success,
+            curve.addCurvePoint(lastPoint)
+        );
+    }
+
+    // after reversal last point is the first one, so it can be reached
+    curve.reverse();
+    EXPECT_EQ(
+        fw::IntersectionCurveAddingResult::LoopedBack,
+        curve.addCurvePoint(lastPoint)
+    );
+    EXPECT_EQ(20001, curve.getCurvePoints().size());
+}
+
+TEST(IntersectionCurveTests, ShouldNotLoopBackWithoutLoopBackDistance)
+{
+    fw::IntersectionCurve curve;
+    curve.setLooping(true);
+    curve.setLoopbackMinimumIndexDifference(20);
+
+    for (auto i = 0; i < 1000; ++i)
+    {
+        ASSERT_EQ(
+            fw::IntersectionCurveAddingResult::Success,
+            curve.addCurvePoint(createHelixPoint(i))
+        );
+    }
+}
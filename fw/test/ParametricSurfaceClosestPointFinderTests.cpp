@@ -0,0 +1,264 @@
+#include "gtest/gtest.h"
+#include "fw/numerical/BsplineEquidistantKnotGenerator.hpp"
+#include "fw/numerical/BsplineNonVanishingReparametrization.hpp"
+#include "fw/numerical/BsplineSurface.hpp"
+#include "fw/numerical/CommonBsplineSurfaces.hpp"
+#include "fw/numerical/EquidistantParametricSurface.hpp"
+#include "fw/numerical/ParametricSurfaceClosestPointFinder.hpp"
+#include "fw/numerical/ParametricSurfaceClosestPointNaiveFinder.hpp"
+#include "TestBsplineSurfaces.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+namespace
+{
+
+// Forwards to wrapped surface and counts evaluated points.
+class EvaluationCountingSurface:
+    public fw::IParametricSurfaceUV
+{
+public:
+    EvaluationCountingSurface(
+        const std::shared_ptr<fw::IParametricSurfaceUV> &surface
+    ):
+        _surface{surface},
+        _evaluationsCount{0}
+    {
+    }
+
+    int getEvaluationsCount() const { return _evaluationsCount; }
+
+    virtual std::shared_ptr<fw::ICurve3d> getConstParameterCurve(
+        fw::ParametrizationAxis constParameter,
+        double parameter
+    ) const override
+    {
+        return _surface->getConstParameterCurve(constParameter, parameter);
+    }
+
+    virtual glm::dvec3 getPosition(glm::dvec2 parametrisation) const override
+    {
+        ++_evaluationsCount;
+        return _surface->getPosition(parametrisation);
+    }
+
+    virtual glm::dvec3 getNormal(glm::dvec2 parametrisation) const override
+    {
+        ++_evaluationsCount;
+        return _surface->getNormal(parametrisation);
+    }
+
+    virtual glm::dvec3 getDerivativeU(
+        glm::dvec2 parametrisation
+    ) const override
+    {
+        ++_evaluationsCount;
+        return _surface->getDerivativeU(parametrisation);
+    }
+
+    virtual glm::dvec3 getDerivativeV(
+        glm::dvec2 parametrisation
+    ) const override
+    {
+        ++_evaluationsCount;
+        return _surface->getDerivativeV(parametrisation);
+    }
+
+    virtual fw::SurfaceEvaluation evaluate(
+        glm::dvec2 parametrisation,
+        int order
+    ) const override
+    {
+        ++_evaluationsCount;
+        return _surface->evaluate(parametrisation, order);
+    }
+
+    virtual void sampleGridRows(
+        glm::dvec2 minimumParameter,
+        glm::dvec2 maximumParameter,
+        glm::ivec2 resolution,
+        int firstRow,
+        int numRows,
+        glm::dvec3 *positions,
+        glm::dvec3 *normals
+    ) const override
+    {
+        _evaluationsCount += resolution.x * numRows;
+        _surface->sampleGridRows(
+            minimumParameter,
+            maximumParameter,
+            resolution,
+            firstRow,
+            numRows,
+            positions,
+            normals
+        );
+    }
+
+private:
+    std::shared_ptr<fw::IParametricSurfaceUV> _surface;
+    mutable int _evaluationsCount;
+};
+
+}
+
+class ParametricSurfaceClosestPointFinderTests:
+    public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        const int gridSize = 8;
+        const int degree = 3;
+
+        std::vector<glm::dvec3> controlPoints;
+        for (auto y = 0; y < gridSize; ++y)
+        {
+            for (auto x = 0; x < gridSize; ++x)
+            {
+                controlPoints.push_back({
+                    static_cast<double>(x),
+                    std::sin(0.9 * x) * std::cos(0.7 * y),
+                    static_cast<double>(y)
+                });
+            }
+        }
+
+        fw::BsplineEquidistantKnotGenerator knotGenerator;
+        auto bsplineSurface = std::make_shared<fw::BsplineSurface>(
+            degree,
+            glm::ivec2(gridSize, gridSize),
+            controlPoints,
+            knotGenerator.generate(gridSize, degree),
+            knotGenerator.generate(gridSize, degree)
+        );
+
+        _surface = std::make_shared<fw::BsplineNonVanishingReparametrization>(
+            bsplineSurface
+        );
+    }
+
+protected:
+    void expectSameAsNaiveFinder(glm::dvec3 referencePoint)
+    {
+        expectSameAsNaiveFinder(*_surface, referencePoint);
+    }
+
+    void expectSameAsNaiveFinder(
+        const fw::IParametricSurfaceUV &surface,
+        glm::dvec3 referencePoint
+    )
+    {
+        fw::ParametricSurfaceClosestPointNaiveFinder naiveFinder;
+        naiveFinder.setReferencePoint(referencePoint);
+        naiveFinder.setSamplingResolution({512, 512});
+        auto naiveParameters = naiveFinder.find(surface);
+
+        fw::ParametricSurfaceClosestPointFinder finder;
+        finder.setReferencePoint(referencePoint);
+        auto parameters = finder.find(surface);
+
+        auto naiveDistance = glm::length(
+            surface.getPosition(naiveParameters) - referencePoint
+        );
+        auto distance = glm::length(
+            surface.getPosition(parameters) - referencePoint
+        );
+
+        EXPECT_LE(distance, naiveDistance + 1e-9);
+        EXPECT_NEAR(naiveParameters.x, parameters.x, 4.0 / 512);
+        EXPECT_NEAR(naiveParameters.y, parameters.y, 4.0 / 512);
+    }
+
+    std::shared_ptr<fw::IParametricSurfaceUV> _surface;
+};
+
+TEST_F(
+    ParametricSurfaceClosestPointFinderTests,
+    ShouldFindSameInteriorPointsAsNaiveFinder
+)
+{
+    expectSameAsNaiveFinder({2.3, 1.5, 3.1});
+    expectSameAsNaiveFinder({4.6, -1.2, 1.7});
+    expectSameAsNaiveFinder({3.3, 0.1, 4.4});
+}
+
+TEST_F(
+    ParametricSurfaceClosestPointFinderTests,
+    ShouldFindClosestPointsOfSurfaceWithoutSecondDerivatives
+)
+{
+    // offset evaluates only first derivatives, so refinement takes
+    // gauss-newton steps
+    fw::EquidistantParametricSurface offset{_surface, 0.3};
+    ASSERT_EQ(1, offset.evaluate({0.5, 0.5}, 2).order);
+
+    expectSameAsNaiveFinder(offset, {2.3, 1.5, 3.1});
+    expectSameAsNaiveFinder(offset, {4.6, -1.2, 1.7});
+}
+
+TEST_F(
+    ParametricSurfaceClosestPointFinderTests,
+    ShouldClampPointsOutsideOfDomainToBoundary
+)
+{
+    fw::ParametricSurfaceClosestPointFinder finder;
+    finder.setReferencePoint({-5.0, 0.0, 3.0});
+    auto parameters = finder.find(*_surface);
+    EXPECT_DOUBLE_EQ(0.0, parameters.x);
+    EXPECT_GT(parameters.y, 0.0);
+    EXPECT_LT(parameters.y, 1.0);
+}
+
+TEST_F(
+    ParametricSurfaceClosestPointFinderTests,
+    ShouldEvaluateSurfaceHundredTimesLessThanNaiveFinder
+)
+{
+    glm::dvec3 referencePoint{2.3, 1.5, 3.1};
+    EvaluationCountingSurface naiveSurface{_surface};
+    EvaluationCountingSurface surface{_surface};
+
+    fw::ParametricSurfaceClosestPointNaiveFinder naiveFinder;
+    naiveFinder.setReferencePoint(referencePoint);
+    naiveFinder.setSamplingResolution({512, 512});
+    naiveFinder.find(naiveSurface);
+
+    fw::ParametricSurfaceClosestPointFinder finder;
+    finder.setReferencePoint(referencePoint);
+    finder.find(surface);
+
+    EXPECT_LE(512 * 512, naiveSurface.getEvaluationsCount());
+    EXPECT_LE(
+        100 * surface.getEvaluationsCount(),
+        naiveSurface.getEvaluationsCount()
+    );
+}
+
+TEST_F(
+    ParametricSurfaceClosestPointFinderTests,
+    ShouldRefineAcrossSeamOfFoldedSurface
+)
+{
+    // wrapped samples lie at v = 0, 0.25, 0.5 and 0.75, the one nearest
+    // to reference point is at v = 0 and refinement has to cross the seam
+    auto tube = std::make_shared<fw::BsplineNonVanishingReparametrization>(
+        createBsplineTube(5.0, 1.0)
+    );
+
+    ASSERT_TRUE(tube->isPeriodic(fw::ParametrizationAxis::V));
+    ASSERT_FALSE(tube->isPeriodic(fw::ParametrizationAxis::U));
+
+    glm::dvec2 expected{0.4, 0.9};
+
+    fw::ParametricSurfaceClosestPointFinder finder;
+    finder.setReferencePoint(tube->getPosition(expected));
+    finder.setSamplingResolution({24, 4});
+    finder.setCandidatesAmount(1);
+    finder.setDomainWrapping(false, true);
+
+    auto parameters = finder.find(*tube);
+    EXPECT_NEAR(expected.x, parameters.x, 1e-6);
+    EXPECT_NEAR(expected.y, parameters.y, 1e-6);
+}
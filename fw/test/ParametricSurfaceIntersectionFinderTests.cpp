@@ -0,0 +1,341 @@
+#include "gtest/gtest.h"
+#include "fw/Common.hpp"
+#include "fw/numerical/BsplineNonVanishingReparametrization.hpp"
+#include "fw/numerical/BsplineSurfacePatchHierarchy.hpp"
+#include "fw/numerical/CommonBsplineSurfaces.hpp"
+#include "fw/numerical/ParametricSurfaceIntersectionFinder.hpp"
+#include "TestBsplineSurfaces.hpp"
+#include <cmath>
+
+namespace
+{
+
+std::shared_ptr<fw::IParametricSurfaceUV> createWavySurface()
+{
+    return std::make_shared<fw::BsplineNonVanishingReparametrization>(
+        createWavyBsplineSurface(8, 0.0, 1.0)
+    );
+}
+
+std::shared_ptr<fw::IParametricSurfaceUV> createLevelPlane(double height)
+{
+    return std::make_shared<fw::BsplineNonVanishingReparametrization>(
+        fw::createBsplinePlane(
+            {-1.0, -1.0, height},
+            {8.0, -1.0, height},
+            {-1.0, 8.0, height},
+            {8.0, 8.0, height}
+        )
+    );
+}
+
+bool isOnDomainBoundary(glm::dvec2 parameters)
+{
+    const double tolerance = 1e-3;
+    return std::min(parameters.x, parameters.y) < tolerance
+        || std::max(parameters.x, parameters.y) > 1.0 - tolerance;
+}
+
+// Total angle swept by xy projection of the curve around given centre.
+double getWindingAngle(
+    const std::vector<fw::ParametricSurfaceIntersection> &curve,
+    glm::dvec2 centre
+)
+{
+    auto angle = 0.0;
+    for (auto i = 1; i < curve.size(); ++i)
+    {
+        auto previous = glm::dvec2{curve[i - 1].scenePosition} - centre;
+        auto current = glm::dvec2{curve[i].scenePosition} - centre;
+        angle += std::atan2(
+            previous.x * current.y - previous.y * current.x,
+            glm::dot(previous, current)
+        );
+    }
+
+    return angle;
+}
+
+}
+
+class ParametricSurfaceIntersectionFinderTests:
+    public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        _horizontalPlane =
+            std::make_shared<fw::BsplineNonVanishingReparametrization>(
+                fw::createBsplinePlane(
+                    {0.0, 0.0, 0.0},
+                    {10.0, 0.0, 0.0},
+                    {0.0, 10.0, 0.0},
+                    {10.0, 10.0, 0.0}
+                )
+            );
+
+        _verticalPlane =
+            std::make_shared<fw::BsplineNonVanishingReparametrization>(
+                fw::createBsplinePlane(
+                    {-5.0, 5.5, -10.0},
+                    {15.0, 5.5, -10.0},
+                    {-5.0, 5.5, 10.0},
+                    {15.0, 5.5, 10.0}
+                )
+            );
+    }
+
+protected:
+    std::shared_ptr<fw::IParametricSurfaceUV> _horizontalPlane;
+    std::shared_ptr<fw::IParametricSurfaceUV> _verticalPlane;
+};
+
+TEST_F(
+    ParametricSurfaceIntersectionFinderTests,
+    ShouldTraceIntersectionWithFewerSolvesThanFixedStep
+)
+{
+    fw::ParametricSurfaceIntersectionFinder fixedStepFinder;
+    auto fixedSettings = fixedStepFinder.getTracingSettings();
+    fixedSettings.minimumStep = fixedSettings.initialStep;
+    fixedSettings.maximumStep = fixedSettings.initialStep;
+    fixedStepFinder.setTracingSettings(fixedSettings);
+
+    auto fixedCurve = fixedStepFinder.intersect(
+        _horizontalPlane,
+        _verticalPlane,
+        glm::vec3{5.0f, 5.5f, 0.0f}
+    );
+
+    fw::ParametricSurfaceIntersectionFinder adaptiveFinder;
+    auto adaptiveCurve = adaptiveFinder.intersect(
+        _horizontalPlane,
+        _verticalPlane,
+        glm::vec3{5.0f, 5.5f, 0.0f}
+    );
+
+    ASSERT_LT(1, adaptiveCurve.size());
+    EXPECT_LT(
+        adaptiveFinder.getNewtonSolvesCount(),
+        fixedStepFinder.getNewtonSolvesCount()
+    );
+
+    for (const auto &point: adaptiveCurve)
+    {
+        EXPECT_NEAR(5.5, point.scenePosition.y, 1e-4);
+        EXPECT_NEAR(0.0, point.scenePosition.z, 1e-4);
+    }
+
+    // both curves should reach surface boundaries
+    auto fixedLength = glm::length(
+        fixedCurve.back().scenePosition - fixedCurve.front().scenePosition
+    );
+    auto adaptiveLength = glm::length(
+        adaptiveCurve.back().scenePosition
+            - adaptiveCurve.front().scenePosition
+    );
+    EXPECT_NEAR(fixedLength, adaptiveLength, 0.1);
+}
+
+TEST_F(
+    ParametricSurfaceIntersectionFinderTests,
+    ShouldTraceCurvedIntersectionToDomainBoundary
+)
+{
+    fw::ParametricSurfaceIntersectionFinder finder;
+    auto curve = finder.intersect(
+        createWavySurface(),
+        createLevelPlane(0.3),
+        glm::vec3{1.5f, 1.5f, 0.3f}
+    );
+
+    ASSERT_LT(2, curve.size());
+    EXPECT_TRUE(isOnDomainBoundary(curve.front().lhsParameters));
+    EXPECT_TRUE(isOnDomainBoundary(curve.back().lhsParameters));
+
+    // open curve is traced in both directions
+    ASSERT_EQ(1, finder.getTracingStops().size());
+    const auto &stop = finder.getTracingStops().front();
+    EXPECT_NE(fw::IntersectionTracingStopReason::LoopClosed, stop.forward);
+    EXPECT_NE(fw::IntersectionTracingStopReason::LoopClosed, stop.backward);
+}
+
+TEST_F(
+    ParametricSurfaceIntersectionFinderTests,
+    ShouldCloseTightIntersectionLoopAtSeed
+)
+{
+    // plane passes just below peak of height 0.7327 at (4.27, 3.93), so
+    // the loop is only ~0.35 long and marching steps shrink on it
+    glm::dvec2 peak{4.27, 3.93};
+
+    fw::ParametricSurfaceIntersectionFinder finder;
+    auto curve = finder.intersect(
+        createWavySurface(),
+        createLevelPlane(0.7317),
+        glm::vec3{peak.x, peak.y, 0.7317}
+    );
+
+    ASSERT_LT(2, curve.size());
+    EXPECT_EQ(curve.front().scenePosition, curve.back().scenePosition);
+    EXPECT_NEAR(2.0 * fw::pi(), std::abs(getWindingAngle(curve, peak)), 1e-6);
+
+    ASSERT_EQ(1, finder.getTracingStops().size());
+    EXPECT_EQ(
+        fw::IntersectionTracingStopReason::LoopClosed,
+        finder.getTracingStops().front().forward
+    );
+}
+
+TEST_F(
+    ParametricSurfaceIntersectionFinderTests,
+    ShouldTraceTightLoopFromPatchPairSeeds
+)
+{
+    // closest points to merged region centre miss this loop, seeds from
+    // overlapping patch pairs lie on it
+    glm::dvec2 peak{4.27, 3.93};
+    auto wavySurface = createWavyBsplineSurface(8, 0.0, 1.0);
+    auto levelPlane = fw::createBsplinePlane(
+        {-1.0, -1.0, 0.7317},
+        {8.0, -1.0, 0.7317},
+        {-1.0, 8.0, 0.7317},
+        {8.0, 8.0, 0.7317}
+    );
+
+    fw::BsplineSurfacePatchHierarchy lhs{*wavySurface};
+    fw::BsplineSurfacePatchHierarchy rhs{*levelPlane};
+    auto seeds = lhs.findIntersectionSeeds(rhs);
+
+    fw::ParametricSurfaceIntersectionFinder finder;
+    auto curves = finder.intersect(
+        std::make_shared<fw::BsplineNonVanishingReparametrization>(
+            wavySurface
+        ),
+        std::make_shared<fw::BsplineNonVanishingReparametrization>(
+            levelPlane
+        ),
+        seeds
+    );
+
+    ASSERT_EQ(1, curves.size());
+    ASSERT_LT(2, curves[0].size());
+    EXPECT_EQ(curves[0].front().scenePosition, curves[0].back().scenePosition);
+    EXPECT_NEAR(
+        2.0 * fw::pi(),
+        std::abs(getWindingAngle(curves[0], peak)),
+        1e-6
+    );
+}
+
+TEST_F(
+    ParametricSurfaceIntersectionFinderTests,
+    ShouldTraceEveryCurveOfSingleSeedRegion
+)
+{
+    // overlaps of the loop around the peak and of the open curve near the
+    // corner touch, so both curves come from one merged region
+    auto wavySurface = createWavyBsplineSurface(8, 0.0, 1.0);
+    auto levelPlane = fw::createBsplinePlane(
+        {-1.0, -1.0, 0.3},
+        {8.0, -1.0, 0.3},
+        {-1.0, 8.0, 0.3},
+        {8.0, 8.0, 0.3}
+    );
+
+    fw::BsplineSurfacePatchHierarchy lhs{*wavySurface};
+    fw::BsplineSurfacePatchHierarchy rhs{*levelPlane};
+    ASSERT_EQ(1, lhs.findIntersectionSeedRegions(rhs).size());
+
+    fw::ParametricSurfaceIntersectionFinder finder;
+    auto curves = finder.intersect(
+        std::make_shared<fw::BsplineNonVanishingReparametrization>(
+            wavySurface
+        ),
+        std::make_shared<fw::BsplineNonVanishingReparametrization>(
+            levelPlane
+        ),
+        lhs.findIntersectionSeeds(rhs)
+    );
+
+    ASSERT_EQ(2, curves.size());
+    auto closedCurves = 0;
+    for (const auto &curve: curves)
+    {
+        ASSERT_LT(2, curve.size());
+        if (curve.front().scenePosition == curve.back().scenePosition)
+        {
+            ++closedCurves;
+            continue;
+        }
+
+        EXPECT_TRUE(isOnDomainBoundary(curve.front().lhsParameters));
+        EXPECT_TRUE(isOnDomainBoundary(curve.back().lhsParameters));
+    }
+
+    EXPECT_EQ(1, closedCurves);
+}
+
+TEST_F(
+    ParametricSurfaceIntersectionFinderTests,
+    ShouldCloseIntersectionLoopAcrossSeamOfFoldedSurface
+)
+{
+    auto tube = std::make_shared<fw::BsplineNonVanishingReparametrization>(
+        createBsplineTube(5.0, 1.0)
+    );
+
+    auto crossSection = std::make_shared<
+        fw::BsplineNonVanishingReparametrization
+    >(
+        fw::createBsplinePlane(
+            {2.5, -2.0, -2.0},
+            {2.5, 2.0, -2.0},
+            {2.5, -2.0, 2.0},
+            {2.5, 2.0, 2.0}
+        )
+    );
+
+    // seed lies on the seam of the tube
+    auto seam = tube->getPosition({0.5, 0.0});
+
+    fw::ParametricSurfaceIntersectionFinder finder;
+    auto curve = finder.intersect(
+        tube,
+        crossSection,
+        glm::vec3{2.5, seam.y, seam.z}
+    );
+
+    ASSERT_LT(2, curve.size());
+    EXPECT_EQ(curve.front().scenePosition, curve.back().scenePosition);
+
+    auto minimumV = 1.0;
+    auto maximumV = 0.0;
+    auto angle = 0.0;
+    for (auto i = 0; i < curve.size(); ++i)
+    {
+        EXPECT_NEAR(2.5, curve[i].scenePosition.x, 1e-6);
+        minimumV = std::min(minimumV, curve[i].lhsParameters.y);
+        maximumV = std::max(maximumV, curve[i].lhsParameters.y);
+
+        if (i > 0)
+        {
+            glm::dvec2 previous{
+                curve[i - 1].scenePosition.y,
+                curve[i - 1].scenePosition.z
+            };
+            glm::dvec2 current{
+                curve[i].scenePosition.y,
+                curve[i].scenePosition.z
+            };
+            angle += std::atan2(
+                previous.x * current.y - previous.y * current.x,
+                glm::dot(previous, current)
+            );
+        }
+    }
+
+    EXPECT_GT(0.05, minimumV);
+    EXPECT_LT(0.95, maximumV);
+    EXPECT_NEAR(2.0 * fw::pi(), std::abs(angle), 1e-6);
+}
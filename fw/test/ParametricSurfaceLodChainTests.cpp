@@ -0,0 +1,102 @@
+#include "fw/numerical/ParametricSurfaceLodChain.hpp"
+#include "fw/numerical/CommonBsplineSurfaces.hpp"
+#include <gtest/gtest.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <memory>
+
+class ParametricSurfaceLodChainTests:
+    public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        auto surface = fw::createBsplinePlane(
+            {0.0, 0.0, 0.0},
+            {1.0, 0.0, 0.0},
+            {0.0, 0.0, 1.0},
+            {1.0, 0.0, 1.0},
+            glm::dmat4(),
+            {8, 8}
+        );
+
+        _lodChain = std::make_shared<fw::ParametricSurfaceLodChain>(
+            surface,
+            std::vector<glm::ivec2>{{8, 8}, {32, 32}, {128, 128}}
+        );
+    }
+
+    virtual void TearDown() override
+    {
+    }
+
+protected:
+    glm::mat4 getViewProjection(float distance) const
+    {
+        return getViewProjection(
+            glm::vec3{0.5f, distance, 0.5f},
+            glm::vec3{0.5f, 0.0f, 0.5f}
+        );
+    }
+
+    glm::mat4 getViewProjection(glm::vec3 eye, glm::vec3 target) const
+    {
+        auto projection = glm::perspective(0.8f, 1.0f, 0.1f, 1000.0f);
+        auto view = glm::lookAt(eye, target, glm::vec3{0.0f, 0.0f, 1.0f});
+        return projection * view;
+    }
+
+    std::shared_ptr<fw::ParametricSurfaceLodChain> _lodChain;
+};
+
+TEST_F(ParametricSurfaceLodChainTests, ShouldSelectCoarserLevelsFartherAway)
+{
+    const glm::ivec2 viewport{1024, 1024};
+    EXPECT_EQ(2, _lodChain->selectLevel(getViewProjection(1.5f), viewport));
+    EXPECT_EQ(1, _lodChain->selectLevel(getViewProjection(20.0f), viewport));
+    EXPECT_EQ(0, _lodChain->selectLevel(getViewProjection(500.0f), viewport));
+}
+
+TEST_F(ParametricSurfaceLodChainTests, ShouldSelectFinestLevelCloseToEye)
+{
+    auto viewProjection = getViewProjection(-0.5f);
+    EXPECT_EQ(2, _lodChain->selectLevel(viewProjection, {1024, 1024}));
+}
+
+TEST_F(ParametricSurfaceLodChainTests, ShouldSelectCoarsestLevelBehindEye)
+{
+    // surface lies 2 units behind the eye, in front of it at the same
+    // distance the finest level would be selected
+    const glm::ivec2 viewport{1024, 1024};
+    auto viewProjection = getViewProjection(
+        glm::vec3{0.5f, 2.0f, 0.5f},
+        glm::vec3{0.5f, 4.0f, 0.5f}
+    );
+
+    EXPECT_EQ(2, _lodChain->selectLevel(getViewProjection(2.0f), viewport));
+    EXPECT_EQ(0, _lodChain->selectLevel(viewProjection, viewport));
+}
+
+TEST_F(ParametricSurfaceLodChainTests, ShouldSelectFinestLevelAcrossEyePlane)
+{
+    // eye looks along the surface, so its bounds cross the plane of the eye
+    auto viewProjection = getViewProjection(
+        glm::vec3{0.5f, -0.5f, 0.5f},
+        glm::vec3{4.0f, -0.5f, 0.5f}
+    );
+
+    EXPECT_EQ(2, _lodChain->selectLevel(viewProjection, {1024, 1024}));
+}
+
+TEST_F(ParametricSurfaceLodChainTests, ShouldBuildRequestedLevelsInBackground)
+{
+    _lodChain->setThreadPool(std::make_shared<fw::ThreadPool>(2));
+
+    _lodChain->requestLevel(2);
+    _lodChain->waitForLevel(2);
+
+    EXPECT_TRUE(_lodChain->isLevelBuilt(2));
+    EXPECT_FALSE(_lodChain->isLevelBuilt(0));
+    EXPECT_FALSE(_lodChain->isLevelBuilt(1));
+}
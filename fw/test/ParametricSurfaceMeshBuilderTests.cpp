@@ -0,0 +1,139 @@
+#include "fw/numerical/ParametricSurfaceMeshBuilder.hpp"
+#include "fw/numerical/CommonBsplineSurfaces.hpp"
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <memory>
+
+class ParametricSurfaceMeshBuilderTests:
+    public ::testing::Test
+{
+public:
+    virtual void SetUp() override
+    {
+        _surface = fw::createBsplinePlane(
+            {0.0, 0.0, 0.0},
+            {1.0, 0.0, 0.0},
+            {0.0, 0.0, 1.0},
+            {1.0, 1.0, 1.0},
+            glm::dmat4(),
+            {8, 8}
+        );
+
+        _builder.setSamplingResolution({33, 17});
+    }
+
+    virtual void TearDown() override
+    {
+    }
+
+protected:
+    std::shared_ptr<fw::BsplineSurface> _surface;
+    fw::ParametricSurfaceMeshBuilder _builder;
+};
+
+TEST_F(ParametricSurfaceMeshBuilderTests, ShouldBuildFullGrid)
+{
+    std::vector<fw::VertexNormalTexCoords> vertices;
+    std::vector<GLuint> indices;
+    _builder.buildGeometry(*_surface, vertices, indices);
+
+    EXPECT_EQ(33 * 17, vertices.size());
+    EXPECT_EQ(6 * 32 * 16, indices.size());
+    EXPECT_EQ(33 * 17 - 1, indices.back());
+}
+
+TEST_F(ParametricSurfaceMeshBuilderTests, ShouldBuildIdenticalMeshInParallel)
+{
+    std::vector<fw::VertexNormalTexCoords> serialVertices, parallelVertices;
+    std::vector<GLuint> serialIndices, parallelIndices;
+
+    _builder.buildGeometry(*_surface, serialVertices, serialIndices);
+
+    _builder.setThreadPool(std::make_shared<fw::ThreadPool>(3));
+    _builder.buildGeometry(*_surface, parallelVertices, parallelIndices);
+
+    ASSERT_EQ(serialVertices.size(), parallelVertices.size());
+    EXPECT_EQ(0, std::memcmp(
+        serialVertices.data(),
+        parallelVertices.data(),
+        serialVertices.size() * sizeof(fw::VertexNormalTexCoords)
+    ));
+    EXPECT_EQ(serialIndices, parallelIndices);
+}
+
+TEST_F(ParametricSurfaceMeshBuilderTests, ShouldUpdateOnlyControlPointSupport)
+{
+    // uneven bounds, so that parameters of samples are rounded
+    const auto &knots = _surface->getKnotsOnU();
+    auto degree = _surface->getDegree();
+    auto first = knots[degree];
+    auto last = knots[knots.size() - degree - 1];
+    glm::dvec2 minimumParameter{
+        glm::mix(first, last, 0.013),
+        glm::mix(first, last, 0.071)
+    };
+    glm::dvec2 maximumParameter{
+        glm::mix(first, last, 0.937),
+        glm::mix(first, last, 0.989)
+    };
+
+    std::vector<fw::VertexNormalTexCoords> vertices, expectedVertices;
+    std::vector<GLuint> indices;
+    _builder.buildGeometry(
+        *_surface,
+        vertices,
+        indices,
+        minimumParameter,
+        maximumParameter
+    );
+
+    _surface->setControlPoint(0, 1, {0.0, 0.3, 0.2});
+
+    auto supports = _surface->getControlPointSupport(0, 1);
+    ASSERT_EQ(1, supports.size());
+
+    auto samples = _builder.updateGeometry(
+        *_surface,
+        supports[0],
+        vertices,
+        minimumParameter,
+        maximumParameter
+    );
+
+    ASSERT_TRUE(samples.isValid());
+    auto numUpdated = (samples.max.x - samples.min.x + 1)
+        * (samples.max.y - samples.min.y + 1);
+    EXPECT_LT(numUpdated, vertices.size() / 4);
+
+    // repeated partial updates have to match full rebuild exactly
+    for (auto i = 1; i < 8; ++i)
+    {
+        _surface->setControlPoint(i, 7 - i, {0.1 * i, 0.3, 0.2 * i});
+        for (const auto &support: _surface->getControlPointSupport(i, 7 - i))
+        {
+            _builder.updateGeometry(
+                *_surface,
+                support,
+                vertices,
+                minimumParameter,
+                maximumParameter
+            );
+        }
+    }
+
+    _builder.buildGeometry(
+        *_surface,
+        expectedVertices,
+        indices,
+        minimumParameter,
+        maximumParameter
+    );
+
+    ASSERT_EQ(expectedVertices.size(), vertices.size());
+    EXPECT_EQ(0, std::memcmp(
+        expectedVertices.data(),
+        vertices.data(),
+        vertices.size() * sizeof(fw::VertexNormalTexCoords)
+    ));
+}
@@ -0,0 +1,37 @@
+#include "gtest/gtest.h"
+#include "fw/numerical/SurfaceIntersectionNewtonIterable.hpp"
+#include "TestBsplineSurfaces.hpp"
+
+TEST(
+    SurfaceIntersectionNewtonIterableTests,
+    ShouldComputeSameJacobianAnalyticallyAndNumerically
+)
+{
+    fw::SurfaceIntersectionNewtonIterable iterable;
+    iterable.setSurfaces(
+        createWavyBsplineSurface(6, 0.0, 1.0),
+        createWavyBsplineSurface(6, 0.3, 1.0)
+    );
+    iterable.setTangentVector({0.3, 1.0, 0.2});
+    iterable.setPlaneDistance(0.04);
+
+    glm::dvec4 parameters{0.41, 0.47, 0.58, 0.52};
+    iterable.setInitialParameters(parameters);
+    iterable.setCurrentParameters(parameters + glm::dvec4{0.01});
+
+    auto analyticJacobianInverse = iterable.getJacobianInverse();
+    iterable.setUsingNumericPlaneDerivatives(true);
+    auto numericJacobianInverse = iterable.getJacobianInverse();
+
+    for (auto column = 0; column < 4; ++column)
+    {
+        for (auto row = 0; row < 4; ++row)
+        {
+            EXPECT_NEAR(
+                numericJacobianInverse[column][row],
+                analyticJacobianInverse[column][row],
+                1e-5
+            );
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include "TestBsplineSurfaces.hpp"
+#include "fw/Common.hpp"
+#include "fw/numerical/BsplineEquidistantKnotGenerator.hpp"
+#include <cmath>
+
+std::shared_ptr<fw::BsplineSurface> createWavyBsplineSurface(
+    int gridSize,
+    double height,
+    double amplitude
+)
+{
+    fw::BsplineEquidistantKnotGenerator knotGenerator;
+
+    std::vector<glm::dvec3> controlPointsGrid;
+    for (auto y = 0; y < gridSize; ++y)
+    {
+        for (auto x = 0; x < gridSize; ++x)
+        {
+            controlPointsGrid.push_back({
+                static_cast<double>(x),
+                static_cast<double>(y),
+                height + amplitude * std::sin(1.1 * x) * std::cos(0.8 * y)
+            });
+        }
+    }
+
+    int degree = 3;
+    return std::make_shared<fw::BsplineSurface>(
+        degree,
+        glm::ivec2{gridSize, gridSize},
+        controlPointsGrid,
+        knotGenerator.generate(gridSize, degree),
+        knotGenerator.generate(gridSize, degree)
+    );
+}
+
+std::shared_ptr<fw::BsplineSurface> createBsplineTube(
+    double length,
+    double radius,
+    glm::ivec2 controlPointsGridSize
+)
+{
+    fw::BsplineEquidistantKnotGenerator knotGenerator;
+
+    std::vector<glm::dvec3> controlPointsGrid;
+    for (auto y = 0; y < controlPointsGridSize.y; ++y)
+    {
+        auto angle = 2.0 * fw::pi() * y / controlPointsGridSize.y;
+        for (auto x = 0; x < controlPointsGridSize.x; ++x)
+        {
+            controlPointsGrid.push_back({
+                length * x / (controlPointsGridSize.x - 1),
+                radius * std::cos(angle),
+                radius * std::sin(angle)
+            });
+        }
+    }
+
+    // folded axis is extended by degree, so its knots cover the copies
+    int degree = 3;
+    return std::make_shared<fw::BsplineSurface>(
+        degree,
+        controlPointsGridSize,
+        controlPointsGrid,
+        knotGenerator.generate(controlPointsGridSize.x, degree),
+        knotGenerator.generate(controlPointsGridSize.y + degree, degree),
+        fw::SurfaceFoldingMode::ContinuousV,
+        degree
+    );
+}
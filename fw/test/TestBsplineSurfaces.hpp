@@ -0,0 +1,20 @@
+#pragma once
+
+#include "fw/numerical/BsplineSurface.hpp"
+#include <memory>
+
+// Cubic height field with control point (x, y) placed at
+// (x, y, height + amplitude * sin(1.1 x) * cos(0.8 y)).
+std::shared_ptr<fw::BsplineSurface> createWavyBsplineSurface(
+    int gridSize,
+    double height,
+    double amplitude
+);
+
+// Cubic tube along x axis, folded on V so that it closes around the axis.
+// Control points of every ring lie on circle of given radius.
+std::shared_ptr<fw::BsplineSurface> createBsplineTube(
+    double length,
+    double radius,
+    glm::ivec2 controlPointsGridSize = {6, 8}
+);
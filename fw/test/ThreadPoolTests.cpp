@@ -0,0 +1,53 @@
+#include "fw/common/ThreadPool.hpp"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+TEST(ThreadPoolTests, ShouldRunEnqueuedTask)
+{
+    fw::ThreadPool threadPool{2};
+    std::atomic<int> counter{0};
+
+    threadPool.enqueue([&counter]() { ++counter; }).get();
+
+    EXPECT_EQ(1, counter.load());
+}
+
+TEST(ThreadPoolTests, ShouldVisitEveryIndexOnceInParallelFor)
+{
+    fw::ThreadPool threadPool{4};
+    std::vector<int> visits(1000, 0);
+
+    threadPool.parallelFor(0, visits.size(), [&visits](int begin, int end) {
+        for (auto i = begin; i < end; ++i) { ++visits[i]; }
+    });
+
+    for (auto visitCount: visits)
+    {
+        EXPECT_EQ(1, visitCount);
+    }
+}
+
+TEST(ThreadPoolTests, ShouldRunTasksInlineWithoutWorkers)
+{
+    fw::ThreadPool threadPool{0};
+    auto visited = false;
+
+    threadPool.parallelFor(0, 1, [&visited](int, int) { visited = true; });
+
+    EXPECT_TRUE(visited);
+}
+
+TEST(ThreadPoolTests, ShouldPropagateExceptionFromParallelFor)
+{
+    fw::ThreadPool threadPool{2};
+
+    EXPECT_THROW(
+        threadPool.parallelFor(0, 8, [](int begin, int) {
+            if (begin == 0) { throw std::runtime_error("failure"); }
+        }),
+        std::runtime_error
+    );
+}